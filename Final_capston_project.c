@@ -15,9 +15,7 @@
     #include <unistd.h>
 #endif
 
-#define MAX_USERS    100
-#define MAX_HOUSES   200
-#define MAX_RENTALS  400
+#define TABLE_MIN_CAP  16
 
 
 typedef enum { ROLE_ADMIN=0, ROLE_LANDLORD=1, ROLE_TENANT=2 } UserRole;
@@ -62,12 +60,33 @@ typedef struct {
     bool is_active;
 } Rental;
 
-User users[MAX_USERS];
-House houses[MAX_HOUSES];
-Rental rentals[MAX_RENTALS];
+// Tables start empty and double in size whenever they fill up.
+User* users = NULL;
+House* houses = NULL;
+Rental* rentals = NULL;
 int user_count = 0;
 int house_count = 0;
 int rental_count = 0;
+int user_cap = 0;
+int house_cap = 0;
+int rental_cap = 0;
+
+void* grow_table(void* table, int* cap, int need, size_t size) {
+    if (need <= *cap) return table;
+    int n = *cap ? *cap : TABLE_MIN_CAP;
+    while (n < need) n *= 2;
+    void* p = realloc(table, (size_t)n * size);
+    if (!p) {
+        printf("Out of memory.\n");
+        exit(1);
+    }
+    *cap = n;
+    return p;
+}
+
+void ensure_users(int need)   { users = grow_table(users, &user_cap, need, sizeof(User)); }
+void ensure_houses(int need)  { houses = grow_table(houses, &house_cap, need, sizeof(House)); }
+void ensure_rentals(int need) { rentals = grow_table(rentals, &rental_cap, need, sizeof(Rental)); }
 
 #ifndef _WIN32
 int getch() {
@@ -317,7 +336,7 @@ void load_users() {
     char line[1024];
     user_count = 0;
 
-    while (fgets(line, sizeof(line), file) && user_count < MAX_USERS) {
+    while (fgets(line, sizeof(line), file)) {
         User user;
         int role, active;
 
@@ -326,6 +345,7 @@ void load_users() {
                   user.email, user.phone, &role, &active) == 8) {
             user.role = (UserRole)role;
             user.is_active = (bool)active;
+            ensure_users(user_count + 1);
             users[user_count++] = user;
         }
     }
@@ -359,7 +379,7 @@ void load_houses() {
     char line[2048];
     house_count = 0;
 
-    while (fgets(line, sizeof(line), file) && house_count < MAX_HOUSES) {
+    while (fgets(line, sizeof(line), file)) {
         House house;
         int status;
 
@@ -368,6 +388,7 @@ void load_houses() {
                   &house.bedrooms, &house.bathrooms, &house.rent, house.description,
                   &house.landlord_id, house.landlord_name, &status, house.date_added) == 13) {
             house.status = (HouseStatus)status;
+            ensure_houses(house_count + 1);
             houses[house_count++] = house;
         }
     }
@@ -402,7 +423,7 @@ void load_rentals() {
     char line[1024];
     rental_count = 0;
 
-    while (fgets(line, sizeof(line), file) && rental_count < MAX_RENTALS) {
+    while (fgets(line, sizeof(line), file)) {
         Rental rental;
         int active;
 
@@ -411,6 +432,7 @@ void load_rentals() {
                   rental.tenant_name, rental.house_title, rental.rental_date,
                   &rental.monthly_rent, &active) == 9) {
             rental.is_active = (bool)active;
+            ensure_rentals(rental_count + 1);
             rentals[rental_count++] = rental;
         }
     }
@@ -493,11 +515,6 @@ User* authenticate() {
 }
 
 void register_user() {
-    if (user_count >= MAX_USERS) {
-        printf("Cannot register more users. System limit reached.\n");
-        return;
-    }
-
     User new_user;
     new_user.id = next_user_id();
 
@@ -553,6 +570,7 @@ void register_user() {
 
     new_user.is_active = true;
 
+    ensure_users(user_count + 1);
     users[user_count++] = new_user;
     save_users();
 
@@ -684,11 +702,6 @@ void landlord_list_my_houses(User* owner) {
 }
 
 void landlord_add_house(User* owner) {
-    if (house_count >= MAX_HOUSES) {
-        printf("Cannot add more houses. System limit reached.\n");
-        return;
-    }
-
     House new_house;
     new_house.id = next_house_id();
 
@@ -708,6 +721,7 @@ void landlord_add_house(User* owner) {
     strcpy(new_house.date_added, today());
     new_house.status = STATUS_AVAILABLE;
 
+    ensure_houses(house_count + 1);
     houses[house_count++] = new_house;
     save_houses();
 
@@ -1006,11 +1020,6 @@ void tenant_rent_house(User* tenant) {
         return;
     }
 
-    if (rental_count >= MAX_RENTALS) {
-        printf("Cannot create more rentals. System limit reached.\n");
-        return;
-    }
-
 
     for (int i = 0; i < rental_count; i++) {
         if (rentals[i].tenant_id == tenant->id &&
@@ -1047,6 +1056,7 @@ void tenant_rent_house(User* tenant) {
     new_rental.monthly_rent = house->rent;
     new_rental.is_active = true;
 
+    ensure_rentals(rental_count + 1);
     rentals[rental_count++] = new_rental;
     house->status = STATUS_RENTED;
 
@@ -1222,24 +1232,23 @@ void create_default_admin() {
     }
 
 
-    if (user_count < MAX_USERS) {
-        User admin;
-        admin.id = next_user_id();
-        strcpy(admin.username, "admin");
-        strcpy(admin.password, "admin123");
-        strcpy(admin.full_name, "System Administrator");
-        strcpy(admin.email, "admin@system.com");
-        strcpy(admin.phone, "1234567890");
-        admin.role = ROLE_ADMIN;
-        admin.is_active = true;
+    User admin;
+    admin.id = next_user_id();
+    strcpy(admin.username, "admin");
+    strcpy(admin.password, "admin123");
+    strcpy(admin.full_name, "System Administrator");
+    strcpy(admin.email, "admin@system.com");
+    strcpy(admin.phone, "1234567890");
+    admin.role = ROLE_ADMIN;
+    admin.is_active = true;
 
-        users[user_count++] = admin;
-        save_users();
+    ensure_users(user_count + 1);
+    users[user_count++] = admin;
+    save_users();
 
-        printf("Default admin account created:\n");
-        printf("Username: admin\n");
-        printf("Password: admin123\n\n");
-    }
+    printf("Default admin account created:\n");
+    printf("Username: admin\n");
+    printf("Password: admin123\n\n");
 }
 
 int main() {
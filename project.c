@@ -1,835 +1,5457 @@
-// house_rental_system_with_animated_splash.c
-// Cross-Platform House Rental Management System (Console)
-// Roles: Admin, Landlord, Tenant
-// Files: users.txt, houses.txt, rentals.txt (pipe-delimited)
-// Input: defensive fgets + validation (no scanf lockups)
-// Splash screen: blinking + gradient + animated reveal
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdbool.h>
-#include <time.h>
-
-#ifdef _WIN32
-  #include <windows.h>
-#else
-  #include <unistd.h>   // usleep (POSIX)
-#endif
-
-// ---------------- Config ----------------
-#define MAX_USERS    1000
-#define MAX_HOUSES   2000
-#define MAX_RENTALS  4000
-
-// Define constants if not available
-#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
-#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
-#endif
-
-#ifndef DISABLE_NEWLINE_AUTO_RETURN
-#define DISABLE_NEWLINE_AUTO_RETURN 0x0008
-#endif
-
-// ---------------- ANSI Colors -----------
-#define RESET   "\x1b[0m"
-#define BLINK   "\x1b[5m"
-#define RED     "\x1b[1;31m"
-#define GREEN   "\x1b[1;32m"
-#define YELLOW  "\x1b[1;33m"
-#define BLUE    "\x1b[1;34m"
-#define PURPLE  "\x1b[1;35m"
-#define CYAN    "\x1b[1;36m"
-#define MAGENTA "\x1b[1;95m"
-
-// ---------------- Sleep helpers ---------
-static void sleep_ms(unsigned ms){
-#ifdef _WIN32
-    Sleep(ms);
-#else
-    usleep(ms * 100);
-#endif
-}
-
-static void sleep_us(unsigned us){
-#ifdef _WIN32
-    // approximate micro-sleeps with ms
-    if(us==0) return;
-    Sleep((us+99)/100);
-#else
-    usleep(us);
-#endif
-}
-
-// ---------------- Clear + VT mode -------
-static void clear_screen(void){
-#ifdef _WIN32
-    system("cls");
-#else
-    system("clear");
-#endif
-}
-
-#ifdef _WIN32
-// Enable Virtual Terminal Processing on Windows 10+
-static void enable_vt_mode(void) {
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    if (hOut == INVALID_HANDLE_VALUE) return;
-
-    DWORD dwMode = 0;
-    if (!GetConsoleMode(hOut, &dwMode)) return;
-
-    // Enable VT processing
-    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-    // Optionally disable newline auto return
-    // dwMode |= DISABLE_NEWLINE_AUTO_RETURN;
-
-    SetConsoleMode(hOut, dwMode);
-}
-
-// Alternative version with error checking
-static int enable_vt_mode_with_check(void) {
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    if (hOut == INVALID_HANDLE_VALUE) {
-        return 0; // Failed to get handle
-    }
-
-    DWORD dwMode = 0;
-    if (!GetConsoleMode(hOut, &dwMode)) {
-        return 0; // Failed to get console mode
-    }
-
-    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-
-    if (!SetConsoleMode(hOut, dwMode)) {
-        return 0; // Failed to set console mode
-    }
-
-    return 1; // Success
-}
-
-#else
-static void enable_vt_mode(void) {
-    // No-op on non-Windows platforms
-}
-
-static int enable_vt_mode_with_check(void) {
-    return 1; // Always succeed on non-Windows
-}
-#endif
-
-// ---------------- Data Types ------------
-typedef enum { ROLE_ADMIN=0, ROLE_LANDLORD=1, ROLE_TENANT=2 } UserRole;
-typedef enum { STATUS_AVAILABLE=0, STATUS_RENTED=1, STATUS_MAINTENANCE=2 } HouseStatus;
-
-typedef struct {
-    int id;
-    char username[50];
-    char password[50];
-    char full_name[100];
-    char email[100];
-    char phone[20];
-    UserRole role;
-    bool is_active;
-} User;
-
-typedef struct {
-    int id;
-    char title[100];
-    char address[200];
-    char city[50];
-    char area[50];
-    int bedrooms;
-    int bathrooms;
-    double rent;
-    char description[500];
-    int landlord_id;
-    char landlord_name[100];
-    HouseStatus status;
-    char date_added[20]; // YYYY-MM-DD
-} House;
-
-typedef struct {
-    int id;
-    int house_id;
-    int tenant_id;
-    int landlord_id;
-    char tenant_name[100];
-    char house_title[100];
-    char rental_date[20]; // YYYY-MM-DD
-    double monthly_rent;
-    bool is_active;
-} Rental;
-
-// ---------------- Globals ----------------
-static User   users[MAX_USERS];     static int user_count=0;
-static House  houses[MAX_HOUSES];   static int house_count=0;
-static Rental rentals[MAX_RENTALS]; static int rental_count=0;
-
-// ---------------- Utilities --------------
-static void trim_newline(char* s){
-    if(s) s[strcspn(s,"\r\n")] = 0;
-}
-
-static void pause_enter(void){
-    printf("\n" YELLOW "Press Enter to continue..." RESET);
-    fflush(stdout);
-    int c;
-    while((c=getchar())!='\n' && c!=EOF) {}
-}
-
-static void input_line(const char* prompt, char* buf, size_t n){
-    if(!prompt || !buf || n==0) return;
-    printf("%s", prompt);
-    fflush(stdout);
-    if(!fgets(buf,(int)n,stdin)){
-        buf[0]='\0';
-        clearerr(stdin);
-        return;
-    }
-    trim_newline(buf);
-}
-
-static int read_int_range(const char* prompt, int minv, int maxv, int def_if_blank, bool allow_blank){
-    char line[64];
-    for(;;){
-        input_line(prompt, line, sizeof(line));
-        if(allow_blank && line[0]=='\0') return def_if_blank;
-        char *end;
-        long v=strtol(line,&end,10);
-        if(end!=line && *end=='\0' && v>=minv && v<=maxv) return (int)v;
-        printf(RED "Invalid integer (expected %d..%d). Try again.\n" RESET, minv, maxv);
-    }
-}
-
-static double read_double_nonneg(const char* prompt, double def_if_blank, bool allow_blank){
-    char line[64];
-    for(;;){
-        input_line(prompt, line, sizeof(line));
-        if(allow_blank && line[0]=='\0') return def_if_blank;
-        char *end;
-        double v=strtod(line,&end);
-        if(end!=line && *end=='\0' && v>=0.0) return v;
-        printf(RED "Invalid number (>=0). Try again.\n" RESET);
-    }
-}
-
-static const char* today(void){
-    static char d[20];
-    time_t t=time(NULL);
-    struct tm* lt=localtime(&t);
-    if(lt) {
-        strftime(d,sizeof(d),"%Y-%m-%d",lt);
-    } else {
-        strncpy(d,"1970-01-01",sizeof(d)-1);
-        d[sizeof(d)-1]='\0';
-    }
-    return d;
-}
-
-static const char* role_str(UserRole r){
-    return (r==ROLE_ADMIN)?"Admin":(r==ROLE_LANDLORD)?"Landlord":"Tenant";
-}
-
-static const char* status_str(HouseStatus s){
-    return (s==STATUS_AVAILABLE)?"Available":(s==STATUS_RENTED)?"Rented":"Maintenance";
-}
-
-static int next_user_id(void){
-    int mx=0;
-    for(int i=0;i<user_count;i++)
-        if(users[i].id>mx) mx=users[i].id;
-    return mx+1;
-}
-
-static int next_house_id(void){
-    int mx=0;
-    for(int i=0;i<house_count;i++)
-        if(houses[i].id>mx) mx=houses[i].id;
-    return mx+1;
-}
-
-static int next_rental_id(void){
-    int mx=0;
-    for(int i=0;i<rental_count;i++)
-        if(rentals[i].id>mx) mx=rentals[i].id;
-    return mx+1;
-}
-
-// ---------------- Splash / Menus ----------
-// Fancy animated splash: blinking + gradient + reveal
-static void type_animated(const char* text, const char* color, unsigned us_per_char){
-    if(!text || !color) return;
-    printf("%s", color);
-    for(size_t i=0; text[i]; ++i){
-        putchar(text[i]);
-        fflush(stdout);
-        sleep_us(us_per_char);
-    }
-    printf(RESET "\n");
-}
-
-static void splash(void){
-    clear_screen();
-    const char* colors[] = {YELLOW};
-    const int ncolors = 1;
-
-    printf(YELLOW "................................\n" RESET);
-    sleep_ms(100);
-
-    const char* msg = " WELCOME TO HOUSE RENTAL SYSTEM";
-    int cidx = 0;
-    for(size_t i=0; msg[i]; ++i){
-        if(msg[i]==' '){
-            putchar(' ');
-        } else {
-            printf("%s%s%c" RESET, colors[cidx], BLINK, msg[i]);
-            cidx = (cidx + 1) % ncolors;
-        }
-        fflush(stdout);
-        sleep_ms(10);  // 10 ms reveal
-    }
-    printf("\n\n");
-    type_animated("      Developed by TCM", PURPLE, 500);
-
-    printf(YELLOW "................................\n" RESET);
-    sleep_ms(1000);
-
-    printf("\n" YELLOW "Press Enter to continue..." RESET);
-    fflush(stdout);
-    int ch;
-    while((ch=getchar())!='\n' && ch!=EOF) {}
-}
-
-// ---------------- File I/O -----------------
-static void load_users(void){
-    FILE* fp=fopen("users.txt","r");
-    if(!fp) return;
-    char line[1024];
-    while(fgets(line,sizeof(line),fp)){
-        User u;
-        memset(&u, 0, sizeof(u));
-        int role, active;
-        if(sscanf(line,"%d|%49[^|]|%49[^|]|%99[^|]|%99[^|]|%19[^|]|%d|%d",
-                  &u.id,u.username,u.password,u.full_name,u.email,u.phone,&role,&active)==8){
-            u.role=(UserRole)role;
-            u.is_active=(bool)active;
-            if(user_count<MAX_USERS) users[user_count++]=u;
-        }
-    }
-    fclose(fp);
-}
-
-static void save_users(void){
-    FILE* fp=fopen("users.txt","w");
-    if(!fp) return;
-    for(int i=0;i<user_count;i++)
-        fprintf(fp,"%d|%s|%s|%s|%s|%s|%d|%d\n",
-            users[i].id,users[i].username,users[i].password,users[i].full_name,
-            users[i].email,users[i].phone,users[i].role,users[i].is_active);
-    fclose(fp);
-}
-
-static void load_houses(void){
-    FILE* fp=fopen("houses.txt","r");
-    if(!fp) return;
-    char line[2048];
-    while(fgets(line,sizeof(line),fp)){
-        House h;
-        memset(&h, 0, sizeof(h));
-        int status;
-        if(sscanf(line,"%d|%99[^|]|%199[^|]|%49[^|]|%49[^|]|%d|%d|%lf|%499[^|]|%d|%99[^|]|%d|%19[^\n]",
-                  &h.id,h.title,h.address,h.city,h.area,&h.bedrooms,&h.bathrooms,&h.rent,
-                  h.description,&h.landlord_id,h.landlord_name,&status,h.date_added)==13){
-            h.status=(HouseStatus)status;
-            if(house_count<MAX_HOUSES) houses[house_count++]=h;
-        }
-    }
-    fclose(fp);
-}
-
-static void save_houses(void){
-    FILE* fp=fopen("houses.txt","w");
-    if(!fp) return;
-    for(int i=0;i<house_count;i++)
-        fprintf(fp,"%d|%s|%s|%s|%s|%d|%d|%.2f|%s|%d|%s|%d|%s\n",
-            houses[i].id,houses[i].title,houses[i].address,houses[i].city,houses[i].area,
-            houses[i].bedrooms,houses[i].bathrooms,houses[i].rent,houses[i].description,
-            houses[i].landlord_id,houses[i].landlord_name,houses[i].status,houses[i].date_added);
-    fclose(fp);
-}
-
-static void load_rentals(void){
-    FILE* fp=fopen("rentals.txt","r");
-    if(!fp) return;
-    char line[1024];
-    while(fgets(line,sizeof(line),fp)){
-        Rental r;
-        memset(&r, 0, sizeof(r));
-        int active;
-        if(sscanf(line,"%d|%d|%d|%d|%99[^|]|%99[^|]|%19[^|]|%lf|%d",
-                  &r.id,&r.house_id,&r.tenant_id,&r.landlord_id,r.tenant_name,
-                  r.house_title,r.rental_date,&r.monthly_rent,&active)==9){
-            r.is_active=(bool)active;
-            if(rental_count<MAX_RENTALS) rentals[rental_count++]=r;
-        }
-    }
-    fclose(fp);
-}
-
-static void save_rentals(void){
-    FILE* fp=fopen("rentals.txt","w");
-    if(!fp) return;
-    for(int i=0;i<rental_count;i++)
-        fprintf(fp,"%d|%d|%d|%d|%s|%s|%s|%.2f|%d\n",
-            rentals[i].id,rentals[i].house_id,rentals[i].tenant_id,rentals[i].landlord_id,
-            rentals[i].tenant_name,rentals[i].house_title,rentals[i].rental_date,
-            rentals[i].monthly_rent,rentals[i].is_active);
-    fclose(fp);
-}
-
-// --------------- Find Helpers -------------
-static User*  find_user_by_id(int id){
-    for(int i=0;i<user_count;i++)
-        if(users[i].id==id) return &users[i];
-    return NULL;
-}
-
-static House* find_house_by_id(int id){
-    for(int i=0;i<house_count;i++)
-        if(houses[i].id==id) return &houses[i];
-    return NULL;
-}
-
-static Rental* find_rental_by_id(int id){
-    for(int i=0;i<rental_count;i++)
-        if(rentals[i].id==id) return &rentals[i];
-    return NULL;
-}
-
-// --------------- Auth ----------------------
-static User* authenticate(void){
-    char uname[64], pw[64];
-    input_line("Username: ", uname, sizeof(uname));
-    input_line("Password: ", pw, sizeof(pw));
-    for(int i=0;i<user_count;i++){
-        if(strcmp(users[i].username,uname)==0 && strcmp(users[i].password,pw)==0){
-            if(!users[i].is_active){
-                printf(RED "Account inactive.\n" RESET);
-                return NULL;
-            }
-            return &users[i];
-        }
-    }
-    printf(RED "Invalid credentials.\n" RESET);
-    return NULL;
-}
-
-static void register_user(void){
-    if(user_count>=MAX_USERS){
-        printf(RED "User capacity reached.\n" RESET);
-        return;
-    }
-    User u;
-    memset(&u,0,sizeof(u));
-    u.id = next_user_id();
-    input_line("Username: ", u.username, sizeof(u.username));
-
-    // uniqueness check
-    for(int i=0;i<user_count;i++){
-        if(strcmp(users[i].username,u.username)==0){
-            printf(RED "Username already exists.\n" RESET);
-            return;
-        }
-    }
-
-    input_line("Password: ", u.password, sizeof(u.password));
-    input_line("Full name: ", u.full_name, sizeof(u.full_name));
-    input_line("Email: ", u.email, sizeof(u.email));
-    input_line("Phone: ", u.phone, sizeof(u.phone));
-    printf("Role: 0=Admin, 1=Landlord, 2=Tenant\n");
-    u.role = (UserRole)read_int_range("Select role: ",0,2,2,false);
-    u.is_active = true;
-    users[user_count++] = u;
-    save_users();
-    printf(GREEN "Registered user with ID %d\n" RESET, u.id);
-}
-
-// --------------- Admin Features ------------
-static void admin_list_users(void){
-    printf(CYAN "\n-- Users --\n" RESET);
-    printf("%-4s | %-14s | %-22s | %-9s | %-6s\n","ID","Username","Full Name","Role","Active");
-    for(int i=0;i<user_count;i++){
-        printf("%-4d | %-14s | %-22s | %-9s | %-6s\n",
-               users[i].id, users[i].username, users[i].full_name,
-               role_str(users[i].role), users[i].is_active?"Yes":"No");
-    }
-}
-
-static void admin_toggle_active(void){
-    int id = read_int_range("User ID to toggle active: ",1,2147483647,0,false);
-    User* u = find_user_by_id(id);
-    if(!u){
-        printf(RED "User not found.\n" RESET);
-        return;
-    }
-    u->is_active = !u->is_active;
-    save_users();
-    printf(GREEN "User %d active=%s\n" RESET, id, u->is_active?"true":"false");
-}
-
-static void admin_reset_password(void){
-    int id = read_int_range("User ID to reset password: ",1,2147483647,0,false);
-    User* u = find_user_by_id(id);
-    if(!u){
-        printf(RED "User not found.\n" RESET);
-        return;
-    }
-    strncpy(u->password,"1234",sizeof(u->password)-1);
-    u->password[sizeof(u->password)-1]='\0';
-    save_users();
-    printf(GREEN "Password reset to '1234' for user %d\n" RESET, id);
-}
-
-static void admin_list_houses(void){
-    printf(CYAN "\n-- Houses --\n" RESET);
-    printf("%-4s | %-18s | %-10s | %-10s | %3s | %3s | %-12s | %-9s\n",
-           "ID","Title","City","Area","Bd","Bt","Status","Rent");
-    for(int i=0;i<house_count;i++){
-        printf("%-4d | %-18s | %-10s | %-10s | %3d | %3d | %-12s | %9.2f\n",
-               houses[i].id, houses[i].title, houses[i].city, houses[i].area,
-               houses[i].bedrooms, houses[i].bathrooms, status_str(houses[i].status),
-               houses[i].rent);
-    }
-}
-
-static void admin_list_rentals(void){
-    printf(CYAN "\n-- Rentals --\n" RESET);
-    printf("%-4s | %-18s | %-18s | %-10s | %-6s | %-9s\n",
-           "ID","Tenant","House","StartDate","Active","Rent");
-    for(int i=0;i<rental_count;i++){
-        printf("%-4d | %-18s | %-18s | %-10s | %-6s | %9.2f\n",
-               rentals[i].id, rentals[i].tenant_name, rentals[i].house_title,
-               rentals[i].rental_date, rentals[i].is_active?"Yes":"No",
-               rentals[i].monthly_rent);
-    }
-}
-
-// --------------- Landlord Features ---------
-static void landlord_list_my_houses(const User* owner){
-    printf(CYAN "\n-- My Houses (%s) --\n" RESET, owner->full_name);
-    printf("%-4s | %-18s | %-10s | %-10s | %3s | %3s | %-12s | %-9s\n",
-           "ID","Title","City","Area","Bd","Bt","Status","Rent");
-    for(int i=0;i<house_count;i++){
-        if(houses[i].landlord_id==owner->id){
-            printf("%-4d | %-18s | %-10s | %-10s | %3d | %3d | %-12s | %9.2f\n",
-                   houses[i].id, houses[i].title, houses[i].city, houses[i].area,
-                   houses[i].bedrooms, houses[i].bathrooms, status_str(houses[i].status),
-                   houses[i].rent);
-        }
-    }
-}
-
-static void landlord_add_house(User* owner){
-    if(house_count>=MAX_HOUSES){
-        printf(RED "House capacity reached.\n" RESET);
-        return;
-    }
-    House h;
-    memset(&h,0,sizeof(h));
-    h.id = next_house_id();
-    input_line("Title: ", h.title, sizeof(h.title));
-    input_line("Address: ", h.address, sizeof(h.address));
-    input_line("City: ", h.city, sizeof(h.city));
-    input_line("Area: ", h.area, sizeof(h.area));
-    h.bedrooms  = read_int_range("Bedrooms (0-50): ",0,50,0,false);
-    h.bathrooms = read_int_range("Bathrooms (0-50): ",0,50,0,false);
-    h.rent      = read_double_nonneg("Monthly Rent: ", 0, false);
-    input_line("Description: ", h.description, sizeof(h.description));
-    h.landlord_id = owner->id;
-    strncpy(h.landlord_name, owner->full_name, sizeof(h.landlord_name)-1);
-    h.landlord_name[sizeof(h.landlord_name)-1] = '\0';
-    strncpy(h.date_added, today(), sizeof(h.date_added)-1);
-    h.date_added[sizeof(h.date_added)-1] = '\0';
-    h.status = STATUS_AVAILABLE;
-    houses[house_count++] = h;
-    save_houses();
-    printf(GREEN "House added with ID %d\n" RESET, h.id);
-}
-
-static void landlord_change_status(User* owner){
-    int id = read_int_range("House ID to change status: ",1,2147483647,0,false);
-    House* h = find_house_by_id(id);
-    if(!h || h->landlord_id!=owner->id){
-        printf(RED "House not found or not yours.\n" RESET);
-        return;
-    }
-    printf("Status: 0=Available, 1=Rented, 2=Maintenance\n");
-    int st = read_int_range("New status: ",0,2,h->status,false);
-    h->status = (HouseStatus)st;
-    save_houses();
-    printf(GREEN "Status updated.\n" RESET);
-}
-
-static void landlord_edit_house(User* owner){
-    int id = read_int_range("House ID to edit: ",1,2147483647,0,false);
-    House* h = find_house_by_id(id);
-    if(!h || h->landlord_id!=owner->id){
-        printf(RED "House not found or not yours.\n" RESET);
-        return;
-    }
-    char line[600];
-    printf(YELLOW "Leave blank to keep current.\n" RESET);
-
-    printf("Title [%s]: ", h->title);
-    fflush(stdout);
-    if(fgets(line,sizeof(line),stdin)){
-        trim_newline(line);
-        if(line[0]){
-            strncpy(h->title,line,sizeof(h->title)-1);
-            h->title[sizeof(h->title)-1] = '\0';
-        }
-    }
-
-    printf("Address [%s]: ", h->address);
-    fflush(stdout);
-    if(fgets(line,sizeof(line),stdin)){
-        trim_newline(line);
-        if(line[0]){
-            strncpy(h->address,line,sizeof(h->address)-1);
-            h->address[sizeof(h->address)-1] = '\0';
-        }
-    }
-
-    printf("City [%s]: ", h->city);
-    fflush(stdout);
-    if(fgets(line,sizeof(line),stdin)){
-        trim_newline(line);
-        if(line[0]){
-            strncpy(h->city,line,sizeof(h->city)-1);
-            h->city[sizeof(h->city)-1] = '\0';
-        }
-    }
-
-    printf("Area [%s]: ", h->area);
-    fflush(stdout);
-    if(fgets(line,sizeof(line),stdin)){
-        trim_newline(line);
-        if(line[0]){
-            strncpy(h->area,line,sizeof(h->area)-1);
-            h->area[sizeof(h->area)-1] = '\0';
-        }
-    }
-
-    h->bedrooms  = read_int_range("Bedrooms (blank keep): ",0,50,h->bedrooms,true);
-    h->bathrooms = read_int_range("Bathrooms (blank keep): ",0,50,h->bathrooms,true);
-    h->rent      = read_double_nonneg("Monthly Rent (blank keep): ",h->rent,true);
-
-    printf("Description [current kept if blank]\n> ");
-    if(fgets(line,sizeof(line),stdin)){
-        trim_newline(line);
-        if(line[0]){
-            strncpy(h->description,line,sizeof(h->description)-1);
-            h->description[sizeof(h->description)-1] = '\0';
-        }
-    }
-
-    save_houses();
-    printf(GREEN "House updated.\n" RESET);
-}
-
-static void landlord_delete_house(User* owner){
-    int id = read_int_range("House ID to delete: ",1,2147483647,0,false);
-    int idx=-1;
-    for(int i=0;i<house_count;i++)
-        if(houses[i].id==id && houses[i].landlord_id==owner->id){
-            idx=i;
-            break;
-        }
-    if(idx<0){
-        printf(RED "House not found or not yours.\n" RESET);
-        return;
-    }
-
-    // Block delete if active rental exists
-    for(int r=0;r<rental_count;r++)
-        if(rentals[r].house_id==id && rentals[r].is_active){
-            printf(RED "Active rental exists; cannot delete.\n" RESET);
-            return;
-        }
-
-    for(int i=idx;i<house_count-1;i++) houses[i]=houses[i+1];
-    house_count--;
-    save_houses();
-    printf(GREEN "House deleted.\n" RESET);
-}
-
-// --------------- Tenant Features ----------
-static void tenant_browse_available(void){
-    printf(CYAN "\n-- Available Houses --\n" RESET);
-    printf("%-4s | %-18s | %-10s | %-10s | %3s | %3s | %-9s\n",
-           "ID","Title","City","Area","Bd","Bt","Rent");
-    for(int i=0;i<house_count;i++){
-        if(houses[i].status==STATUS_AVAILABLE){
-            printf("%-4d | %-18s | %-10s | %-10s | %3d | %3d | %9.2f\n",
-                   houses[i].id, houses[i].title, houses[i].city, houses[i].area,
-                   houses[i].bedrooms, houses[i].bathrooms, houses[i].rent);
-        }
-    }
-}
-
-static void tenant_view_my_rentals(const User* t){
-    printf(CYAN "\n-- My Rentals --\n" RESET);
-    printf("%-4s | %-18s | %-10s | %-6s | %-9s\n","ID","House","StartDate","Active","Rent");
-    for(int i=0;i<rental_count;i++){
-        if(rentals[i].tenant_id==t->id){
-            printf("%-4d | %-18s | %-10s | %-6s | %9.2f\n",
-                   rentals[i].id, rentals[i].house_title, rentals[i].rental_date,
-                   rentals[i].is_active?"Yes":"No", rentals[i].monthly_rent);
-        }
-    }
-}
-
-static void tenant_rent_house(User* t){
-    int hid = read_int_range("Enter House ID to rent: ",1,2147483647,0,false);
-    House* h = find_house_by_id(hid);
-    if(!h || h->status!=STATUS_AVAILABLE){
-        printf(RED "House not found or not available.\n" RESET);
-        return;
-    }
-    if(rental_count>=MAX_RENTALS){
-        printf(RED "Rental capacity reached.\n" RESET);
-        return;
-    }
-
-    Rental r;
-    memset(&r,0,sizeof(r));
-    r.id = next_rental_id();
-    r.house_id = h->id;
-    r.tenant_id= t->id;
-    r.landlord_id = h->landlord_id;
-    strncpy(r.tenant_name, t->full_name, sizeof(r.tenant_name)-1);
-    r.tenant_name[sizeof(r.tenant_name)-1] = '\0';
-    strncpy(r.house_title, h->title, sizeof(r.house_title)-1);
-    r.house_title[sizeof(r.house_title)-1] = '\0';
-    strncpy(r.rental_date, today(), sizeof(r.rental_date)-1);
-    r.rental_date[sizeof(r.rental_date)-1] = '\0';
-    r.monthly_rent = h->rent;
-    r.is_active = true;
-
-    rentals[rental_count++] = r;
-    h->status = STATUS_RENTED;
-    save_rentals();
-    save_houses();
-    printf(GREEN "Rental created. Rental ID %d\n" RESET, r.id);
-}
-
-static void tenant_end_rental(User* t){
-    int rid = read_int_range("Rental ID to end: ",1,2147483647,0,false);
-    Rental* r = find_rental_by_id(rid);
-    if(!r || r->tenant_id!=t->id){
-        printf(RED "Rental not found or not yours.\n" RESET);
-        return;
-    }
-    if(!r->is_active){
-        printf(YELLOW "Rental already inactive.\n" RESET);
-        return;
-    }
-    r->is_active=false;
-    House* h = find_house_by_id(r->house_id);
-    if(h && h->status==STATUS_RENTED) h->status=STATUS_AVAILABLE;
-    save_rentals();
-    save_houses();
-    printf(GREEN "Rental ended.\n" RESET);
-}
-
-// --------------- Role Menus ---------------
-static void admin_menu(void){
-    for(;;){
-        clear_screen();
-        printf(RED "==================== A D M I N ====================\n" RESET);
-        printf("1. List Users\n2. Toggle User Active\n3. Reset User Password\n4. List Houses\n5. List Rentals\n6. Back\n");
-        int c = read_int_range("Choice: ",1,6,6,false);
-        if(c==1) admin_list_users();
-        else if(c==2) admin_toggle_active();
-        else if(c==3) admin_reset_password();
-        else if(c==4) admin_list_houses();
-        else if(c==5) admin_list_rentals();
-        else break;
-        pause_enter();
-    }
-}
-
-static void landlord_menu(User* me){
-    for(;;){
-        clear_screen();
-        printf(RED "================== L A N D L O R D =================\n" RESET);
-        printf("1. Add House\n2. Edit House\n3. Delete House\n4. Change House Status\n5. My Houses\n6. Back\n");
-        int c = read_int_range("Choice: ",1,6,6,false);
-        if(c==1) landlord_add_house(me);
-        else if(c==2) landlord_edit_house(me);
-        else if(c==3) landlord_delete_house(me);
-        else if(c==4) landlord_change_status(me);
-        else if(c==5) landlord_list_my_houses(me);
-        else break;
-        pause_enter();
-    }
-}
-
-static void tenant_menu(User* me){
-    for(;;){
-        clear_screen();
-        printf(RED "=================== T E N A N T ====================\n" RESET);
-        printf("1. Browse Available Houses\n2. Rent a House\n3. My Rentals\n4. End Rental\n5. Back\n");
-        int c = read_int_range("Choice: ",1,5,5,false);
-        if(c==1) tenant_browse_available();
-        else if(c==2) tenant_rent_house(me);
-        else if(c==3) tenant_view_my_rentals(me);
-        else if(c==4) tenant_end_rental(me);
-        else break;
-        pause_enter();
-    }
-}
-
-// ---------------- Main Menu ---------------
-static int menu_main(void){
-    clear_screen();
-    printf(RED "======================\n");
-    printf("   M A I N  M E N U\n");
-    printf(RED "======================\n" RESET);
-    printf(GREEN  "1. Login\n" RESET);
-    printf(YELLOW "2. Register\n" RESET);
-    printf(RED    "3. Exit\n" RESET);
-    return read_int_range("Choose an option: ",1,3,3,false);
-}
-
-// -------------------- main ----------------
-int main(void){
-    enable_vt_mode();  // ANSI colors on Windows 10+ terminals
-    splash();          // fancy animated welcome
-
-    load_users();
-    load_houses();
-    load_rentals();
-
-    for(;;){
-        int choice = menu_main();
-        if(choice==1){
-            User* u = authenticate();
-            if(u){
-                if(u->role==ROLE_ADMIN) admin_menu();
-                else if(u->role==ROLE_LANDLORD) landlord_menu(u);
-                else tenant_menu(u);
-            } else {
-                pause_enter();
-            }
-        } else if(choice==2){
-            register_user();
-            pause_enter();
-        } else {
-            printf(GREEN "Goodbye!\n" RESET);
-            break;
-        }
-    }
-    return 0;
-}
+// house_rental_system_with_animated_splash.c
+// Cross-Platform House Rental Management System (Console)
+// Roles: Admin, Landlord, Tenant
+// Files: users.txt, houses.txt, rentals.txt (pipe-delimited, import/export)
+//        rental.hrs binary snapshot of all tables, preferred when newest
+//        *.jnl append-only journals of changes since the last snapshot
+//        rentals_archive.txt ended rentals kept on disk only (archive mode)
+// Input: defensive fgets + validation (no scanf lockups)
+// Splash screen: blinking + gradient + animated reveal
+// Build: gcc -O2 project.c -o project -pthread -lm   (add -mavx2 for AVX2 scans)
+// Usage: project                      interactive menus
+//        project --import <users|houses|rentals> <file> [...]   bulk load
+//        project --bench-<filter|load|lookup|login|browse|search|tables|scan> [...]
+//                                     timings on synthetic data (see Benchmarks)
+// Env:   HRS_SYNC_WRITES=1 flushes every change before the menu returns
+//        HRS_WRITE_BEHIND_MS=<ms> sets the group-commit window (default 50)
+//        HRS_ARCHIVE_RENTALS=1 moves ended rentals to rentals_archive.txt
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h> // stat, fstat
+
+#ifdef _WIN32
+  // Condition variables need Vista; older MinGW headers default below that.
+  #if !defined(_WIN32_WINNT) || _WIN32_WINNT < 0x0600
+    #undef  _WIN32_WINNT
+    #define _WIN32_WINNT 0x0600
+  #endif
+  #include <windows.h>
+  #include <io.h>       // _commit
+#else
+  #include <pthread.h>
+  #include <unistd.h>   // usleep, fsync (POSIX)
+  #include <fcntl.h>    // open
+  #include <sys/mman.h> // mmap
+#endif
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+#endif
+
+// ---------------- Config ----------------
+#define TABLE_MIN_CAP    64      // first allocation of a growable table
+
+#define USERS_FILE       "users.txt"
+#define HOUSES_FILE      "houses.txt"
+#define RENTALS_FILE     "rentals.txt"
+#define USERS_JOURNAL    "users.jnl"
+#define HOUSES_JOURNAL   "houses.jnl"
+#define RENTALS_JOURNAL  "rentals.jnl"
+#define RENTALS_ARCHIVE  "rentals_archive.txt"
+#define SNAPSHOT_FILE    "rental.hrs"
+#define SNAPSHOT_VERSION 2
+#define JOURNAL_COMPACT_AT 256   // journal entries per table before a new snapshot
+#define LOAD_MAX_THREADS     16
+#define PARALLEL_LOAD_BYTES  (4u<<20)   // smaller houses.txt files load on one thread
+#define BROWSE_PAGE_SIZE     20
+#define TOP_K_MAX            500
+#ifndef WRITE_BEHIND_MS
+#define WRITE_BEHIND_MS  50      // default group-commit window; see persist_start()
+#endif
+
+// Define constants if not available
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+
+#ifndef DISABLE_NEWLINE_AUTO_RETURN
+#define DISABLE_NEWLINE_AUTO_RETURN 0x0008
+#endif
+
+// ---------------- ANSI Colors -----------
+#define RESET   "\x1b[0m"
+#define BLINK   "\x1b[5m"
+#define RED     "\x1b[1;31m"
+#define GREEN   "\x1b[1;32m"
+#define YELLOW  "\x1b[1;33m"
+#define BLUE    "\x1b[1;34m"
+#define PURPLE  "\x1b[1;35m"
+#define CYAN    "\x1b[1;36m"
+#define MAGENTA "\x1b[1;95m"
+
+// ---------------- Sleep helpers ---------
+static void sleep_ms(unsigned ms){
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    usleep(ms * 100);
+#endif
+}
+
+static void sleep_us(unsigned us){
+#ifdef _WIN32
+    // approximate micro-sleeps with ms
+    if(us==0) return;
+    Sleep((us+99)/100);
+#else
+    usleep(us);
+#endif
+}
+
+// ---------------- Threads ---------------
+#ifdef _WIN32
+typedef HANDLE             Thread;
+typedef CRITICAL_SECTION   Mutex;
+typedef CONDITION_VARIABLE Cond;
+#define THREAD_FUNC DWORD WINAPI
+
+static bool thread_start(Thread* t, LPTHREAD_START_ROUTINE fn, void* arg){
+    *t=CreateThread(NULL,0,fn,arg,0,NULL);
+    return *t!=NULL;
+}
+static void thread_join(Thread t){ WaitForSingleObject(t,INFINITE); CloseHandle(t); }
+static void mutex_init(Mutex* m){ InitializeCriticalSection(m); }
+static void mutex_lock(Mutex* m){ EnterCriticalSection(m); }
+static void mutex_unlock(Mutex* m){ LeaveCriticalSection(m); }
+static void cond_init(Cond* c){ InitializeConditionVariable(c); }
+static void cond_signal(Cond* c){ WakeConditionVariable(c); }
+static void cond_wait(Cond* c, Mutex* m){ SleepConditionVariableCS(c,m,INFINITE); }
+static void cond_wait_ms(Cond* c, Mutex* m, unsigned ms){ SleepConditionVariableCS(c,m,ms); }
+#else
+typedef pthread_t       Thread;
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t  Cond;
+#define THREAD_FUNC void*
+
+static bool thread_start(Thread* t, void* (*fn)(void*), void* arg){
+    return pthread_create(t,NULL,fn,arg)==0;
+}
+static void thread_join(Thread t){ pthread_join(t,NULL); }
+static void mutex_init(Mutex* m){ pthread_mutex_init(m,NULL); }
+static void mutex_lock(Mutex* m){ pthread_mutex_lock(m); }
+static void mutex_unlock(Mutex* m){ pthread_mutex_unlock(m); }
+static void cond_init(Cond* c){ pthread_cond_init(c,NULL); }
+static void cond_signal(Cond* c){ pthread_cond_signal(c); }
+static void cond_wait(Cond* c, Mutex* m){ pthread_cond_wait(c,m); }
+static void cond_wait_ms(Cond* c, Mutex* m, unsigned ms){
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME,&ts);
+    ts.tv_sec+=ms/1000;
+    ts.tv_nsec+=(long)(ms%1000)*1000000L;
+    if(ts.tv_nsec>=1000000000L){ ts.tv_sec++; ts.tv_nsec-=1000000000L; }
+    pthread_cond_timedwait(c,m,&ts);
+}
+#endif
+
+static int cpu_count(void){
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    int n=(int)si.dwNumberOfProcessors;
+#else
+    int n=(int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return n>0?n:1;
+}
+
+// Flush a stdio stream all the way to the disk.
+static bool fsync_file(FILE* fp){
+    if(fflush(fp)!=0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(fp))==0;
+#else
+    return fsync(fileno(fp))==0;
+#endif
+}
+
+// ---------------- Clear + VT mode -------
+static void clear_screen(void){
+#ifdef _WIN32
+    system("cls");
+#else
+    system("clear");
+#endif
+}
+
+#ifdef _WIN32
+// Enable Virtual Terminal Processing on Windows 10+
+static void enable_vt_mode(void) {
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (hOut == INVALID_HANDLE_VALUE) return;
+
+    DWORD dwMode = 0;
+    if (!GetConsoleMode(hOut, &dwMode)) return;
+
+    // Enable VT processing
+    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+    // Optionally disable newline auto return
+    // dwMode |= DISABLE_NEWLINE_AUTO_RETURN;
+
+    SetConsoleMode(hOut, dwMode);
+}
+
+// Alternative version with error checking
+static int enable_vt_mode_with_check(void) {
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (hOut == INVALID_HANDLE_VALUE) {
+        return 0; // Failed to get handle
+    }
+
+    DWORD dwMode = 0;
+    if (!GetConsoleMode(hOut, &dwMode)) {
+        return 0; // Failed to get console mode
+    }
+
+    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+
+    if (!SetConsoleMode(hOut, dwMode)) {
+        return 0; // Failed to set console mode
+    }
+
+    return 1; // Success
+}
+
+#else
+static void enable_vt_mode(void) {
+    // No-op on non-Windows platforms
+}
+
+static int enable_vt_mode_with_check(void) {
+    return 1; // Always succeed on non-Windows
+}
+#endif
+
+// ---------------- Data Types ------------
+typedef enum { ROLE_ADMIN=0, ROLE_LANDLORD=1, ROLE_TENANT=2 } UserRole;
+typedef enum { STATUS_AVAILABLE=0, STATUS_RENTED=1, STATUS_MAINTENANCE=2, STATUS_COUNT=3 } HouseStatus;
+typedef enum { TABLE_USERS=0, TABLE_HOUSES=1, TABLE_RENTALS=2, TABLE_COUNT=3 } TableId;
+typedef int Sym;   // an interned string; see Symbols
+typedef struct { uint32_t off, len; } Str;   // text held in a table's Arena
+
+// Longest accepted user fields, terminator included. Text is kept at its
+// real length in the arenas, but input stays within these widths (and the
+// House arrays below) on purpose: the table files are shared with
+// Final_capston_project.c, whose sscanf formats read exactly these widths.
+#define USERNAME_MAX  50
+#define PASSWORD_MAX  50
+#define FULL_NAME_MAX 100
+#define EMAIL_MAX     100
+#define PHONE_MAX     20
+
+typedef struct {
+    int id;
+    Str username, password, full_name, email, phone;   // in user_arena
+    UserRole role;
+    bool is_active;
+} User;
+
+typedef struct {
+    int id;
+    char title[100];
+    char address[200];
+    char city[50];
+    char area[50];
+    int bedrooms;
+    int bathrooms;
+    double rent;
+    char description[500];
+    int landlord_id;
+    char landlord_name[100];
+    HouseStatus status;
+    char date_added[20]; // YYYY-MM-DD
+} House;
+
+// In memory a house is split by slot into a hot row, which is all that
+// browsing, filtering and index upkeep read, and its cold text, which only
+// detail views, edits, the text index and persistence touch. House above is
+// the whole record as files, journals and editors see it.
+typedef struct {
+    int id;
+    HouseStatus status;
+    double rent;
+    int bedrooms;
+    int bathrooms;
+    int landlord_id;
+    int city, area;      // facet ids (interned keys); -1 until faceted
+} HouseRow;
+
+// Column copies of the numeric house fields, by slot, for the filter
+// kernels; kept in step with houses[] wherever a row is stored or moved.
+typedef struct {
+    int32_t* bedrooms;
+    int32_t* bathrooms;
+    int64_t* rent_cents;
+    uint8_t* status;
+} HouseColumns;
+
+typedef struct {
+    Str  title, address, description;   // in house_arena
+    Sym  city_sym, area_sym, landlord_sym;
+    char date_added[20];
+} HouseText;
+
+typedef struct {
+    int id;
+    int house_id;
+    int tenant_id;
+    int landlord_id;
+    char rental_date[20]; // YYYY-MM-DD
+    double monthly_rent;
+    bool is_active;
+} Rental;
+
+// Tenant name and house title as rental files carry them. In memory a
+// rental names its tenant and house by id only; see Rental Names.
+#define RENTAL_NAME_MAX 100
+typedef struct { char tenant[RENTAL_NAME_MAX], title[RENTAL_NAME_MAX]; } RentalNames;
+
+// ---------------- Globals ----------------
+// Tables grow by doubling, so a pointer into one stays valid only until the
+// next append to that same table.
+static User*   users;   static int user_count=0,   user_cap=0;
+static HouseRow* houses; static HouseText* house_text;   // parallel, by slot
+static HouseColumns house_cols;                          // likewise
+static int house_count=0, house_cap=0;
+static Rental* rentals; static int rental_count=0, rental_cap=0;
+static int id_seq[TABLE_COUNT];     // last id handed out per table; persisted in rental.hrs
+static bool ids_ascending[TABLE_COUNT]={true,true,true};  // slot order is id order
+
+// ---------------- Arenas -----------------
+// User and house text is stored at its real length, terminator included,
+// in one growable buffer per table; records hold (offset, length) handles.
+// Text that an edit or delete lets go of stays behind as garbage until the
+// table is compacted. Like table rows, a pointer from arena_str() is only
+// good until the next append to the same arena. An arena has one writer at
+// a time; the parallel house loader gives each chunk its own.
+typedef struct {
+    char*  data;
+    size_t len, cap;
+    size_t live;     // bytes referenced by records in the table
+} Arena;
+
+#define ARENA_MIN_CAP     4096
+#define ARENA_COMPACT_MIN (64u<<10)  // garbage worth a compaction pass
+
+static Arena user_arena, house_arena;
+
+// Make room for n more bytes; offsets must stay within 32 bits.
+static void arena_reserve(Arena* a, size_t n){
+    if(a->len+n<=a->cap) return;
+    size_t cap=a->cap?a->cap:ARENA_MIN_CAP;
+    while(cap<a->len+n) cap*=2;
+    char* p=(a->len+n<=UINT32_MAX)?realloc(a->data,cap):NULL;
+    if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    a->data=p;
+    a->cap=cap;
+}
+
+// Append s; the empty string takes no space.
+static Str arena_put(Arena* a, const char* s){
+    Str h={0,0};
+    size_t n=strlen(s);
+    if(n==0) return h;
+    size_t at=(a->data && s>=a->data && s<a->data+a->len)?(size_t)(s-a->data):SIZE_MAX;
+    arena_reserve(a,n+1);
+    if(at!=SIZE_MAX) s=a->data+at;   // s was text of this arena
+    memcpy(a->data+a->len,s,n+1);
+    h.off=(uint32_t)a->len;
+    h.len=(uint32_t)n;
+    a->len+=n+1;
+    return h;
+}
+
+static const char* arena_str(const Arena* a, Str s){ return s.len?a->data+s.off:""; }
+static size_t str_bytes(Str s){ return s.len?s.len+1:0; }
+
+// Move one live handle into the compacted buffer at *at.
+static void arena_move(const Arena* a, char* to, size_t* at, Str* s){
+    if(!s->len) return;
+    memcpy(to+*at,a->data+s->off,s->len+1);
+    s->off=(uint32_t)*at;
+    *at+=s->len+1;
+}
+
+static const char* user_str(Str s){  return arena_str(&user_arena,s); }
+static const char* house_str(Str s){ return arena_str(&house_arena,s); }
+
+// ---------------- Utilities --------------
+static void trim_newline(char* s){
+    if(s) s[strcspn(s,"\r\n")] = 0;
+}
+
+static void pause_enter(void){
+    printf("\n" YELLOW "Press Enter to continue..." RESET);
+    fflush(stdout);
+    int c;
+    while((c=getchar())!='\n' && c!=EOF) {}
+}
+
+static void input_line(const char* prompt, char* buf, size_t n){
+    if(!prompt || !buf || n==0) return;
+    for(;;){
+        printf("%s", prompt);
+        fflush(stdout);
+        if(!fgets(buf,(int)n,stdin)){
+            buf[0]='\0';
+            clearerr(stdin);
+            return;
+        }
+        size_t len = strlen(buf);
+        if(len==0 || len+1<n || buf[len-1]=='\n') break;
+        // The buffer filled up: accept it only if the line ends right here,
+        // otherwise drop the rest and ask again rather than cut it short.
+        int c = getchar();
+        if(c=='\n' || c==EOF) break;
+        while((c=getchar())!='\n' && c!=EOF) {}
+        printf(RED "Too long (at most %u characters). Try again.\n" RESET,(unsigned)(n-1));
+    }
+    trim_newline(buf);
+}
+
+static int read_int_range(const char* prompt, int minv, int maxv, int def_if_blank, bool allow_blank){
+    char line[64];
+    for(;;){
+        input_line(prompt, line, sizeof(line));
+        if(allow_blank && line[0]=='\0') return def_if_blank;
+        char *end;
+        long v=strtol(line,&end,10);
+        if(end!=line && *end=='\0' && v>=minv && v<=maxv) return (int)v;
+        printf(RED "Invalid integer (expected %d..%d). Try again.\n" RESET, minv, maxv);
+    }
+}
+
+static double read_double_nonneg(const char* prompt, double def_if_blank, bool allow_blank){
+    char line[64];
+    for(;;){
+        input_line(prompt, line, sizeof(line));
+        if(allow_blank && line[0]=='\0') return def_if_blank;
+        char *end;
+        double v=strtod(line,&end);
+        if(end!=line && *end=='\0' && v>=0.0) return v;
+        printf(RED "Invalid number (>=0). Try again.\n" RESET);
+    }
+}
+
+static const char* today(void){
+    static char d[20];
+    time_t t=time(NULL);
+    struct tm* lt=localtime(&t);
+    if(lt) {
+        strftime(d,sizeof(d),"%Y-%m-%d",lt);
+    } else {
+        strncpy(d,"1970-01-01",sizeof(d)-1);
+        d[sizeof(d)-1]='\0';
+    }
+    return d;
+}
+
+static double now_seconds(void){
+#ifdef _WIN32
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart/(double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (double)ts.tv_sec+ts.tv_nsec/1e9;
+#endif
+}
+
+static bool is_valid_email(const char* email){
+    if(!email || strlen(email)<5) return false;
+    int len=(int)strlen(email), at_count=0, at_pos=-1;
+    if(email[0]=='@' || email[0]=='.' || email[len-1]=='@' || email[len-1]=='.') return false;
+    for(int i=0;i<len;i++)
+        if(email[i]=='@'){ at_count++; at_pos=i; }
+    if(at_count!=1 || at_pos<=0 || at_pos>=len-2) return false;
+    for(int i=at_pos+1;i<len;i++){
+        if(email[i]=='.'){
+            if(i==at_pos+1 || i==len-1) return false; // dot right after @ or at end
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool is_valid_phone(const char* phone){
+    if(!phone) return false;
+    int len=(int)strlen(phone), digits=0;
+    if(len<7 || len>15) return false;
+    for(int i=0;i<len;i++){
+        if(isdigit((unsigned char)phone[i])) digits++;
+        else if(!strchr("+- ()",phone[i])) return false;
+    }
+    return digits>=7;
+}
+
+static const char* role_str(UserRole r){
+    return (r==ROLE_ADMIN)?"Admin":(r==ROLE_LANDLORD)?"Landlord":"Tenant";
+}
+
+static const char* status_str(HouseStatus s){
+    return (s==STATUS_AVAILABLE)?"Available":(s==STATUS_RENTED)?"Rented":"Maintenance";
+}
+
+// Ids come from per-table sequences that only move forward, so an id is never
+// handed out twice, even after the record holding the highest one is deleted.
+// Hand out n consecutive ids and return the first.
+static int reserve_ids(TableId t, int n){
+    int first=id_seq[t]+1;
+    id_seq[t]+=n;
+    return first;
+}
+
+// Give back the unused tail of the latest reservation; next is the first id
+// that was not used.
+static void release_ids(TableId t, int next){
+    if(next-1<id_seq[t]) id_seq[t]=next-1;
+}
+
+// Make room for need records; the arrays start empty and only ever double.
+static void table_reserve(void** rows, int* cap, int need, size_t size){
+    if(need<=*cap) return;
+    size_t n=*cap?(size_t)*cap:TABLE_MIN_CAP;
+    while(n<(size_t)need) n*=2;
+    if(n>INT_MAX) n=INT_MAX;
+    void* p=realloc(*rows,n*size);
+    if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    *rows=p;
+    *cap=(int)n;
+}
+
+static void reserve_users(int n){   table_reserve((void**)&users,&user_cap,n,sizeof(User)); }
+static void reserve_houses(int n){
+    int cap=house_cap;
+    table_reserve((void**)&house_text,&cap,n,sizeof(HouseText));
+    cap=house_cap; table_reserve((void**)&house_cols.bedrooms,&cap,n,sizeof(int32_t));
+    cap=house_cap; table_reserve((void**)&house_cols.bathrooms,&cap,n,sizeof(int32_t));
+    cap=house_cap; table_reserve((void**)&house_cols.rent_cents,&cap,n,sizeof(int64_t));
+    cap=house_cap; table_reserve((void**)&house_cols.status,&cap,n,sizeof(uint8_t));
+    table_reserve((void**)&houses,&house_cap,n,sizeof(HouseRow));
+}
+
+// Rent in whole cents for the filter columns. NaN maps below every bound,
+// so like the double it fails any rent condition.
+static int64_t rent_cents(double rent){
+    if(rent!=rent) return INT64_MIN;
+    if(rent>=9.2e16) return INT64_MAX;
+    if(rent<=-9.2e16) return INT64_MIN+1;
+    return (int64_t)llround(rent*100.0);
+}
+
+// Rent as stored: whole cents, like the files keep it, so the rent index,
+// the facets and the cent columns all see the same value.
+static double round_rent(double rent){
+    int64_t c=rent_cents(rent);
+    return (c==INT64_MIN || c==INT64_MAX || c==INT64_MIN+1)?rent:(double)c/100.0;
+}
+
+// Move n slots of the columns from one slot to another (overlap allowed).
+static void house_cols_move(int to, int from, int n){
+    memmove(&house_cols.bedrooms[to],&house_cols.bedrooms[from],(size_t)n*sizeof(int32_t));
+    memmove(&house_cols.bathrooms[to],&house_cols.bathrooms[from],(size_t)n*sizeof(int32_t));
+    memmove(&house_cols.rent_cents[to],&house_cols.rent_cents[from],(size_t)n*sizeof(int64_t));
+    memmove(&house_cols.status[to],&house_cols.status[from],(size_t)n*sizeof(uint8_t));
+}
+
+static size_t house_text_bytes(const HouseText* t){
+    return str_bytes(t->title)+str_bytes(t->address)+str_bytes(t->description);
+}
+
+static Sym intern(const char* s);
+static const char* sym_str(Sym s);
+
+// The hot row, columns and date of a whole record; house_store() adds the
+// text and symbols.
+static void house_store_row(int slot, const House* h){
+    HouseRow* r=&houses[slot];
+    r->id=h->id;
+    r->status=h->status;
+    r->rent=h->rent;
+    r->bedrooms=h->bedrooms;
+    r->bathrooms=h->bathrooms;
+    r->landlord_id=h->landlord_id;
+    r->city=r->area=-1;
+    house_cols.bedrooms[slot]=h->bedrooms;
+    house_cols.bathrooms[slot]=h->bathrooms;
+    house_cols.rent_cents[slot]=rent_cents(h->rent);
+    house_cols.status[slot]=(uint8_t)h->status;
+    memcpy(house_text[slot].date_added,h->date_added,sizeof(house_text[slot].date_added));
+}
+
+// Split a whole record into slot; facet ids are filled in when it is faceted.
+static void house_store(int slot, const House* h){
+    HouseText* t=&house_text[slot];
+    house_store_row(slot,h);
+    t->title=arena_put(&house_arena,h->title);
+    t->address=arena_put(&house_arena,h->address);
+    t->description=arena_put(&house_arena,h->description);
+    house_arena.live+=house_text_bytes(t);
+    t->city_sym=intern(h->city);
+    t->area_sym=intern(h->area);
+    t->landlord_sym=intern(h->landlord_name);
+}
+
+// Reassemble the whole record of slot.
+static void house_load(int slot, House* h){
+    const HouseRow* r=&houses[slot];
+    const HouseText* t=&house_text[slot];
+    h->id=r->id;
+    h->status=r->status;
+    h->rent=r->rent;
+    h->bedrooms=r->bedrooms;
+    h->bathrooms=r->bathrooms;
+    h->landlord_id=r->landlord_id;
+    snprintf(h->title,sizeof(h->title),"%s",house_str(t->title));
+    snprintf(h->address,sizeof(h->address),"%s",house_str(t->address));
+    snprintf(h->city,sizeof(h->city),"%s",sym_str(t->city_sym));
+    snprintf(h->area,sizeof(h->area),"%s",sym_str(t->area_sym));
+    snprintf(h->description,sizeof(h->description),"%s",house_str(t->description));
+    snprintf(h->landlord_name,sizeof(h->landlord_name),"%s",sym_str(t->landlord_sym));
+    memcpy(h->date_added,t->date_added,sizeof(h->date_added));
+}
+
+static HouseText* text_of(const HouseRow* r){ return &house_text[r-houses]; }
+
+// Text a record stops referencing when it is replaced or deleted; it stays
+// in the arena until the next compaction.
+static void house_release(int slot){ house_arena.live-=house_text_bytes(&house_text[slot]); }
+
+static size_t user_text_bytes(const User* u){
+    return str_bytes(u->username)+str_bytes(u->password)+str_bytes(u->full_name)+
+           str_bytes(u->email)+str_bytes(u->phone);
+}
+
+// Copy a user's text into user_arena. The record counts as live text only
+// once it is in the table.
+static void user_set_text(User* u, const char* username, const char* password,
+                          const char* full_name, const char* email, const char* phone){
+    u->username=arena_put(&user_arena,username);
+    u->password=arena_put(&user_arena,password);
+    u->full_name=arena_put(&user_arena,full_name);
+    u->email=arena_put(&user_arena,email);
+    u->phone=arena_put(&user_arena,phone);
+}
+
+// Replace one text field of a user already in the table.
+static void user_set_field(Str* f, const char* v){
+    user_arena.live-=str_bytes(*f);
+    *f=arena_put(&user_arena,v);
+    user_arena.live+=str_bytes(*f);
+}
+
+// Compact when garbage outweighs live text and is big enough to bother.
+static bool arena_wasteful(const Arena* a){
+    size_t junk=a->len-a->live;
+    return junk>=ARENA_COMPACT_MIN && junk>a->live;
+}
+
+// Swap in a buffer holding only referenced text, laid out in slot order.
+static char* arena_begin_compact(size_t need, size_t* cap){
+    *cap=need>ARENA_MIN_CAP?need:ARENA_MIN_CAP;
+    char* to=malloc(*cap);
+    if(!to){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    return to;
+}
+
+static void arena_end_compact(Arena* a, char* to, size_t len, size_t cap){
+    free(a->data);
+    a->data=to;
+    a->len=a->live=len;
+    a->cap=cap;
+}
+
+static void compact_user_text(void){
+    size_t cap, at=0, need=0;
+    for(int i=0;i<user_count;i++) need+=user_text_bytes(&users[i]);
+    char* to=arena_begin_compact(need,&cap);
+    for(int i=0;i<user_count;i++){
+        User* u=&users[i];
+        arena_move(&user_arena,to,&at,&u->username);
+        arena_move(&user_arena,to,&at,&u->password);
+        arena_move(&user_arena,to,&at,&u->full_name);
+        arena_move(&user_arena,to,&at,&u->email);
+        arena_move(&user_arena,to,&at,&u->phone);
+    }
+    arena_end_compact(&user_arena,to,at,cap);
+}
+
+static void compact_house_text(void){
+    size_t cap, at=0, need=0;
+    for(int i=0;i<house_count;i++) need+=house_text_bytes(&house_text[i]);
+    char* to=arena_begin_compact(need,&cap);
+    for(int i=0;i<house_count;i++){
+        HouseText* t=&house_text[i];
+        arena_move(&house_arena,to,&at,&t->title);
+        arena_move(&house_arena,to,&at,&t->address);
+        arena_move(&house_arena,to,&at,&t->description);
+    }
+    arena_end_compact(&house_arena,to,at,cap);
+}
+
+static void reserve_rentals(int n){ table_reserve((void**)&rentals,&rental_cap,n,sizeof(Rental)); }
+
+static void seq_observe(TableId t, int id){
+    if(id>id_seq[t]) id_seq[t]=id;
+}
+
+// Deletes keep slot order, so a table stays id-ordered until a row lands
+// behind a larger id (an import or journal replay of an old id).
+static void track_id_order(TableId t, int slot, int id, int prev_id){
+    if(slot==0) ids_ascending[t]=true;
+    else if(id<prev_id) ids_ascending[t]=false;
+}
+
+static int next_user_id(void){   return reserve_ids(TABLE_USERS,1); }
+static int next_house_id(void){  return reserve_ids(TABLE_HOUSES,1); }
+static int next_rental_id(void){ return reserve_ids(TABLE_RENTALS,1); }
+
+// ---------------- Splash / Menus ----------
+// Fancy animated splash: blinking + gradient + reveal
+static void type_animated(const char* text, const char* color, unsigned us_per_char){
+    if(!text || !color) return;
+    printf("%s", color);
+    for(size_t i=0; text[i]; ++i){
+        putchar(text[i]);
+        fflush(stdout);
+        sleep_us(us_per_char);
+    }
+    printf(RESET "\n");
+}
+
+static void splash(void){
+    clear_screen();
+    const char* colors[] = {YELLOW};
+    const int ncolors = 1;
+
+    printf(YELLOW "................................\n" RESET);
+    sleep_ms(100);
+
+    const char* msg = " WELCOME TO HOUSE RENTAL SYSTEM";
+    int cidx = 0;
+    for(size_t i=0; msg[i]; ++i){
+        if(msg[i]==' '){
+            putchar(' ');
+        } else {
+            printf("%s%s%c" RESET, colors[cidx], BLINK, msg[i]);
+            cidx = (cidx + 1) % ncolors;
+        }
+        fflush(stdout);
+        sleep_ms(10);  // 10 ms reveal
+    }
+    printf("\n\n");
+    type_animated("      Developed by TCM", PURPLE, 500);
+
+    printf(YELLOW "................................\n" RESET);
+    sleep_ms(1000);
+
+    printf("\n" YELLOW "Press Enter to continue..." RESET);
+    fflush(stdout);
+    int ch;
+    while((ch=getchar())!='\n' && ch!=EOF) {}
+}
+
+// --------------- Id Indexes ---------------
+// Open-addressing (linear probing) map from record id to array slot, one per
+// table. Deletes use backward shifting, so there are no tombstones.
+typedef struct {
+    int* keys;
+    int* slots;      // -1 = empty bucket
+    int  cap;        // power of two
+    int  count;
+} IdIndex;
+
+static IdIndex user_index, house_index, rental_index;
+
+static unsigned id_hash(int key, int cap){
+    return ((unsigned)key*2654435761u)&(unsigned)(cap-1);
+}
+
+static void idx_alloc(IdIndex* ix, int cap){
+    ix->keys=malloc((size_t)cap*sizeof(int));
+    ix->slots=malloc((size_t)cap*sizeof(int));
+    if(!ix->keys || !ix->slots){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    for(int i=0;i<cap;i++) ix->slots[i]=-1;
+    ix->cap=cap;
+    ix->count=0;
+}
+
+static void idx_put(IdIndex* ix, int key, int slot);
+
+static void idx_grow(IdIndex* ix){
+    IdIndex old=*ix;
+    idx_alloc(ix,old.cap?old.cap*2:64);
+    for(int i=0;i<old.cap;i++)
+        if(old.slots[i]>=0) idx_put(ix,old.keys[i],old.slots[i]);
+    free(old.keys);
+    free(old.slots);
+}
+
+static void idx_put(IdIndex* ix, int key, int slot){
+    if((ix->count+1)*10>ix->cap*7) idx_grow(ix);   // keep load <= 0.7
+    unsigned mask=(unsigned)ix->cap-1, i=id_hash(key,ix->cap);
+    while(ix->slots[i]>=0 && ix->keys[i]!=key) i=(i+1)&mask;
+    if(ix->slots[i]<0) ix->count++;
+    ix->keys[i]=key;
+    ix->slots[i]=slot;
+}
+
+static int idx_get(const IdIndex* ix, int key){
+    if(!ix->cap) return -1;
+    unsigned mask=(unsigned)ix->cap-1, i=id_hash(key,ix->cap);
+    while(ix->slots[i]>=0){
+        if(ix->keys[i]==key) return ix->slots[i];
+        i=(i+1)&mask;
+    }
+    return -1;
+}
+
+static void idx_del(IdIndex* ix, int key){
+    if(!ix->cap) return;
+    unsigned mask=(unsigned)ix->cap-1, i=id_hash(key,ix->cap);
+    while(ix->slots[i]>=0 && ix->keys[i]!=key) i=(i+1)&mask;
+    if(ix->slots[i]<0) return;
+    // Pull later entries of the probe run back into the hole.
+    for(unsigned j=(i+1)&mask; ix->slots[j]>=0; j=(j+1)&mask){
+        unsigned home=id_hash(ix->keys[j],ix->cap);
+        if(((j-home)&mask) >= ((j-i)&mask)){
+            ix->keys[i]=ix->keys[j];
+            ix->slots[i]=ix->slots[j];
+            i=j;
+        }
+    }
+    ix->slots[i]=-1;
+    ix->count--;
+}
+
+static void idx_clear(IdIndex* ix){
+    for(int i=0;i<ix->cap;i++) ix->slots[i]=-1;
+    ix->count=0;
+}
+
+// Secondary indexes: key (landlord id, ...) -> ids of the records holding it.
+// Lists keep record ids rather than slots so they survive the shifting in
+// remove_*_at; each id resolves through the id index in O(1). Ids are kept
+// ascending; new records have the highest id, so adds are appends.
+typedef struct { int* ids; int len, cap; } IdList;
+
+typedef struct {
+    IdIndex keys;     // key -> list number
+    IdList* lists;
+    int count, cap;
+} MultiIndex;
+
+static MultiIndex landlord_houses, landlord_rentals, tenant_rentals;
+static IdIndex    house_active_rental;   // house id -> id of its active rental
+
+static void multi_add(MultiIndex* mi, int key, int id){
+    int n=idx_get(&mi->keys,key);
+    if(n<0){
+        if(mi->count==mi->cap){
+            int cap=mi->cap?mi->cap*2:64;
+            IdList* p=realloc(mi->lists,(size_t)cap*sizeof(IdList));
+            if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+            memset(p+mi->cap,0,(size_t)(cap-mi->cap)*sizeof(IdList));
+            mi->lists=p;
+            mi->cap=cap;
+        }
+        n=mi->count++;
+        mi->lists[n].len=0;
+        idx_put(&mi->keys,key,n);
+    }
+    IdList* l=&mi->lists[n];
+    if(l->len==l->cap){
+        int cap=l->cap?l->cap*2:4;
+        int* p=realloc(l->ids,(size_t)cap*sizeof(int));
+        if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+        l->ids=p;
+        l->cap=cap;
+    }
+    int i=l->len++;
+    while(i>0 && l->ids[i-1]>id){ l->ids[i]=l->ids[i-1]; i--; }
+    l->ids[i]=id;
+}
+
+static void multi_del(MultiIndex* mi, int key, int id){
+    int n=idx_get(&mi->keys,key);
+    if(n<0) return;
+    IdList* l=&mi->lists[n];
+    int lo=0, hi=l->len;
+    while(lo<hi){
+        int mid=(lo+hi)/2;
+        if(l->ids[mid]<id) lo=mid+1; else hi=mid;
+    }
+    if(lo==l->len || l->ids[lo]!=id) return;
+    memmove(l->ids+lo,l->ids+lo+1,(size_t)(l->len-lo-1)*sizeof(int));
+    l->len--;
+}
+
+static const IdList* multi_get(const MultiIndex* mi, int key){
+    int n=idx_get(&mi->keys,key);
+    return (n>=0)?&mi->lists[n]:NULL;
+}
+
+// List buffers are kept for reuse.
+static void multi_clear(MultiIndex* mi){
+    idx_clear(&mi->keys);
+    mi->count=0;
+}
+
+static void index_rental_active(const Rental* r){
+    if(r->is_active) idx_put(&house_active_rental,r->house_id,r->id);
+}
+
+static void unindex_rental_active(const Rental* r){
+    if(r->is_active && idx_get(&house_active_rental,r->house_id)==r->id)
+        idx_del(&house_active_rental,r->house_id);
+}
+
+static void index_rental(const Rental* r){
+    multi_add(&landlord_rentals,r->landlord_id,r->id);
+    multi_add(&tenant_rentals,r->tenant_id,r->id);
+    index_rental_active(r);
+}
+
+static void unindex_rental(const Rental* r){
+    multi_del(&landlord_rentals,r->landlord_id,r->id);
+    multi_del(&tenant_rentals,r->tenant_id,r->id);
+    unindex_rental_active(r);
+}
+
+// One bitmap per HouseStatus over house slots. Bits at or past house_count are
+// always zero, so counts are plain popcounts and removal shifts later bits down
+// in step with remove_house_at.
+typedef struct { uint64_t* words; int nwords; } Bitmap;
+
+static Bitmap status_bits[STATUS_COUNT];
+
+static unsigned ctz64(uint64_t x){
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i,x);
+    return (unsigned)i;
+#else
+    return (unsigned)__builtin_ctzll(x);
+#endif
+}
+
+static int popcount64(uint64_t x){
+#if defined(_MSC_VER)
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+static void bitmap_set(Bitmap* b, int i, bool on){
+    int w=i>>6;
+    if(w>=b->nwords){
+        if(!on) return;
+        int n=b->nwords?b->nwords*2:64;
+        while(n<=w) n*=2;
+        uint64_t* p=realloc(b->words,(size_t)n*sizeof(uint64_t));
+        if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+        memset(p+b->nwords,0,(size_t)(n-b->nwords)*sizeof(uint64_t));
+        b->words=p;
+        b->nwords=n;
+    }
+    uint64_t m=1ull<<(i&63);
+    if(on) b->words[w]|=m; else b->words[w]&=~m;
+}
+
+// Drop bit i out of the first n and move the bits above it down one place.
+static void bitmap_remove_at(Bitmap* b, int i, int n){
+    int w=i>>6, last=(n-1)>>6;
+    if(w>=b->nwords) return;
+    if(last>=b->nwords) last=b->nwords-1;
+    uint64_t keep=(1ull<<(i&63))-1;
+    uint64_t* x=b->words;
+    x[w]=(x[w]&keep) | ((x[w]>>1)&~keep);
+    for(int k=w;k<last;k++){
+        x[k]|=x[k+1]<<63;
+        x[k+1]>>=1;
+    }
+}
+
+// First set bit at or after from, below n; -1 when there is none.
+static int bitmap_next(const Bitmap* b, int from, int n){
+    int w=from>>6;
+    if(w>=b->nwords || from>=n) return -1;
+    uint64_t x=b->words[w]&(~0ull<<(from&63));
+    int end=(n+63)>>6;
+    if(end>b->nwords) end=b->nwords;
+    for(;;){
+        if(x){
+            int i=(w<<6)+(int)ctz64(x);
+            return (i<n)?i:-1;
+        }
+        if(++w>=end) return -1;
+        x=b->words[w];
+    }
+}
+
+static int bitmap_count(const Bitmap* b, int n){
+    int end=(n+63)>>6, c=0;
+    if(end>b->nwords) end=b->nwords;
+    for(int w=0;w<end;w++) c+=popcount64(b->words[w]);
+    return c;
+}
+
+static void bitmap_clear(Bitmap* b){
+    if(b->nwords) memset(b->words,0,(size_t)b->nwords*sizeof(uint64_t));
+}
+
+static void index_house_status(int slot, bool on){
+    HouseStatus st=houses[slot].status;
+    if((unsigned)st<STATUS_COUNT) bitmap_set(&status_bits[st],slot,on);
+}
+
+// Ordered index over (rent, house id): a skip list with back links on the
+// bottom level, so range scans run in either direction in O(log n + k).
+// It covers every house; callers filter on status while they walk it.
+#define RENT_MAX_LEVEL 24
+
+typedef struct RentNode {
+    double rent;
+    int id;
+    struct RentNode* prev;      // level 0 only; NULL for the first node
+    struct RentNode* next[];    // one link per level
+} RentNode;
+
+static struct {
+    RentNode* head;             // sentinel with RENT_MAX_LEVEL links
+    RentNode* tail;
+    int level;
+    uint32_t rng;
+} rent_index;
+
+static double rent_key(double rent){ return (rent==rent)?rent:-1.0; }   // NaN sorts first
+
+static bool rent_less(double ra, int ia, double rb, int ib){
+    return ra<rb || (ra==rb && ia<ib);
+}
+
+static int rent_random_level(void){
+    uint32_t x=rent_index.rng?rent_index.rng:0x9e3779b9u;
+    x^=x<<13; x^=x>>17; x^=x<<5;   // xorshift32
+    rent_index.rng=x;
+    int lvl=1;
+    while(lvl<RENT_MAX_LEVEL && (x&3)==0){ lvl++; x>>=2; }   // p = 1/4
+    return lvl;
+}
+
+static RentNode* rent_node_alloc(int level){
+    RentNode* n=calloc(1,sizeof(RentNode)+(size_t)level*sizeof(RentNode*));
+    if(!n){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    return n;
+}
+
+// Fill upd[] with the last node before (rent,id) on every level.
+static void rent_find(double rent, int id, RentNode** upd){
+    RentNode* x=rent_index.head;
+    for(int l=rent_index.level-1;l>=0;l--){
+        while(x->next[l] && rent_less(x->next[l]->rent,x->next[l]->id,rent,id)) x=x->next[l];
+        upd[l]=x;
+    }
+}
+
+static void rent_insert(double rent, int id){
+    if(!rent_index.head){
+        rent_index.head=rent_node_alloc(RENT_MAX_LEVEL);
+        rent_index.level=1;
+    }
+    rent=rent_key(rent);
+    RentNode* upd[RENT_MAX_LEVEL];
+    rent_find(rent,id,upd);
+    int lvl=rent_random_level();
+    for(int l=rent_index.level;l<lvl;l++) upd[l]=rent_index.head;
+    if(lvl>rent_index.level) rent_index.level=lvl;
+    RentNode* n=rent_node_alloc(lvl);
+    n->rent=rent;
+    n->id=id;
+    for(int l=0;l<lvl;l++){
+        n->next[l]=upd[l]->next[l];
+        upd[l]->next[l]=n;
+    }
+    n->prev=(upd[0]==rent_index.head)?NULL:upd[0];
+    if(n->next[0]) n->next[0]->prev=n; else rent_index.tail=n;
+}
+
+static void rent_delete(double rent, int id){
+    if(!rent_index.head) return;
+    rent=rent_key(rent);
+    RentNode* upd[RENT_MAX_LEVEL];
+    rent_find(rent,id,upd);
+    RentNode* n=upd[0]->next[0];
+    if(!n || n->id!=id || n->rent!=rent) return;
+    for(int l=0;l<rent_index.level && upd[l]->next[l]==n;l++) upd[l]->next[l]=n->next[l];
+    if(n->next[0]) n->next[0]->prev=n->prev; else rent_index.tail=n->prev;
+    free(n);
+    while(rent_index.level>1 && !rent_index.head->next[rent_index.level-1]) rent_index.level--;
+}
+
+// First node at or after (rent,id); NULL when there is none.
+static RentNode* rent_seek(double rent, int id){
+    if(!rent_index.head) return NULL;
+    RentNode* upd[RENT_MAX_LEVEL];
+    rent_find(rent,id,upd);
+    return upd[0]->next[0];
+}
+
+// Last node at or before (rent,id); NULL when there is none.
+static RentNode* rent_seek_back(double rent, int id){
+    RentNode* n=rent_seek(rent,id);
+    if(n && n->rent==rent && n->id==id) return n;
+    return n?n->prev:rent_index.tail;
+}
+
+typedef struct { double rent; int id; } RentKey;
+
+static int rent_key_cmp(const void* a, const void* b){
+    const RentKey* x=(const RentKey*)a;
+    const RentKey* y=(const RentKey*)b;
+    if(rent_less(x->rent,x->id,y->rent,y->id)) return -1;
+    return rent_less(y->rent,y->id,x->rent,x->id);
+}
+
+static void rent_clear(void);
+
+// Bulk build for reloads: sort once, then append every node at the tail,
+// which avoids a search (and its cache misses) per house.
+static void rent_rebuild(void){
+    rent_clear();
+    if(!house_count) return;
+    RentKey* keys=malloc((size_t)house_count*sizeof(RentKey));
+    if(!keys){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    for(int i=0;i<house_count;i++){
+        keys[i].rent=rent_key(houses[i].rent);
+        keys[i].id=houses[i].id;
+    }
+    qsort(keys,(size_t)house_count,sizeof(RentKey),rent_key_cmp);
+    if(!rent_index.head){
+        rent_index.head=rent_node_alloc(RENT_MAX_LEVEL);
+        rent_index.level=1;
+    }
+    RentNode* last[RENT_MAX_LEVEL];
+    for(int l=0;l<RENT_MAX_LEVEL;l++) last[l]=rent_index.head;
+    RentNode* prev=NULL;
+    for(int i=0;i<house_count;i++){
+        int lvl=rent_random_level();
+        if(lvl>rent_index.level) rent_index.level=lvl;
+        RentNode* n=rent_node_alloc(lvl);
+        n->rent=keys[i].rent;
+        n->id=keys[i].id;
+        n->prev=prev;
+        for(int l=0;l<lvl;l++){
+            last[l]->next[l]=n;
+            last[l]=n;
+        }
+        prev=n;
+    }
+    rent_index.tail=prev;
+    free(keys);
+}
+
+static void rent_clear(void){
+    if(!rent_index.head) return;
+    for(RentNode* n=rent_index.head->next[0]; n; ){
+        RentNode* next=n->next[0];
+        free(n);
+        n=next;
+    }
+    memset(rent_index.head->next,0,RENT_MAX_LEVEL*sizeof(RentNode*));
+    rent_index.tail=NULL;
+    rent_index.level=1;
+}
+
+static void reindex_users(void){
+    idx_clear(&user_index);
+    for(int i=0;i<user_count;i++){
+        idx_put(&user_index,users[i].id,i);
+        track_id_order(TABLE_USERS,i,users[i].id,i?users[i-1].id:0);
+    }
+}
+
+static void reindex_houses(void){
+    idx_clear(&house_index);
+    multi_clear(&landlord_houses);
+    for(int s=0;s<STATUS_COUNT;s++) bitmap_clear(&status_bits[s]);
+    rent_rebuild();
+    for(int i=0;i<house_count;i++){
+        idx_put(&house_index,houses[i].id,i);
+        track_id_order(TABLE_HOUSES,i,houses[i].id,i?houses[i-1].id:0);
+        index_house_status(i,true);
+        multi_add(&landlord_houses,houses[i].landlord_id,houses[i].id);
+    }
+}
+
+static void reindex_rentals(void){
+    idx_clear(&rental_index);
+    multi_clear(&landlord_rentals);
+    multi_clear(&tenant_rentals);
+    idx_clear(&house_active_rental);
+    for(int i=0;i<rental_count;i++){
+        idx_put(&rental_index,rentals[i].id,i);
+        track_id_order(TABLE_RENTALS,i,rentals[i].id,i?rentals[i-1].id:0);
+        index_rental(&rentals[i]);
+    }
+}
+
+// --------------- Find Helpers -------------
+static User*  find_user_by_id(int id){
+    int i=idx_get(&user_index,id);
+    return (i>=0)?&users[i]:NULL;
+}
+
+static HouseRow* find_house_by_id(int id){
+    int i=idx_get(&house_index,id);
+    return (i>=0)?&houses[i]:NULL;
+}
+
+static Rental* find_rental_by_id(int id){
+    int i=idx_get(&rental_index,id);
+    return (i>=0)?&rentals[i]:NULL;
+}
+
+// -------------- Rental Names --------------
+// Rentals show the current full name of their tenant and title of their
+// house, joined through the id indexes, so an edit shows up everywhere at
+// once. Ended rentals outlive the houses they name, so the last title of a
+// deleted house (and the name of a removed user) is kept here, by id, while
+// a rental in memory still refers to it. The rental files still write both
+// names; loading seeds this store from them and prune_all_departed() then
+// drops every id that is live or no longer referenced. Archived rows read
+// through the cursor carry their own names and never enter the store.
+typedef struct { int id; Str name; } DepartedName;
+
+typedef struct {
+    IdIndex ids;     // house or user id -> entry
+    DepartedName* entries;
+    int count, cap;
+    Arena text;
+} DepartedNames;
+
+static DepartedNames departed_titles, departed_tenants;
+
+static void departed_put(DepartedNames* d, int id, const char* name){
+    if(!name[0] || idx_get(&d->ids,id)>=0) return;
+    table_reserve((void**)&d->entries,&d->cap,d->count+1,sizeof(DepartedName));
+    DepartedName* e=&d->entries[d->count];
+    e->id=id;
+    e->name=arena_put(&d->text,name);
+    d->text.live+=str_bytes(e->name);
+    idx_put(&d->ids,id,d->count++);
+}
+
+static const char* departed_name(const DepartedNames* d, int id){
+    int e=idx_get(&d->ids,id);
+    return (e>=0)?arena_str(&d->text,d->entries[e].name):"";
+}
+
+// Keep the names of ids that are not in live but are in used, repacked.
+static void prune_departed(DepartedNames* d, const IdIndex* live, const IdIndex* used){
+    int n=0;
+    size_t need=0;
+    for(int i=0;i<d->count;i++){
+        int id=d->entries[i].id;
+        if(idx_get(live,id)>=0 || idx_get(used,id)<0) continue;
+        d->entries[n++]=d->entries[i];
+        need+=str_bytes(d->entries[i].name);
+    }
+    free(d->ids.keys);
+    free(d->ids.slots);
+    memset(&d->ids,0,sizeof(d->ids));
+    size_t cap, at=0;
+    char* to=arena_begin_compact(need,&cap);
+    for(int i=0;i<n;i++){
+        arena_move(&d->text,to,&at,&d->entries[i].name);
+        idx_put(&d->ids,d->entries[i].id,i);
+    }
+    arena_end_compact(&d->text,to,at,cap);
+    d->count=n;
+}
+
+// Drop the names of ids that came back or that no rental in memory refers
+// to any more; run after loading and after rentals leave for the archive.
+static void prune_all_departed(void){
+    IdIndex tenants={0}, titles={0};
+    for(int i=0;i<rental_count;i++){
+        idx_put(&tenants,rentals[i].tenant_id,i);
+        idx_put(&titles,rentals[i].house_id,i);
+    }
+    prune_departed(&departed_tenants,&user_index,&tenants);
+    prune_departed(&departed_titles,&house_index,&titles);
+    free(tenants.keys); free(tenants.slots);
+    free(titles.keys); free(titles.slots);
+}
+
+// Record the names a table rental was read with for whichever of its tenant
+// and house is not (or not yet, while loading) in the tables.
+static void note_departed(const Rental* r, const RentalNames* n){
+    if(!find_user_by_id(r->tenant_id)) departed_put(&departed_tenants,r->tenant_id,n->tenant);
+    if(!find_house_by_id(r->house_id)) departed_put(&departed_titles,r->house_id,n->title);
+}
+
+// True when a rental in memory refers to the house; they are found through
+// the landlord's rentals, since a house keeps its landlord.
+static bool house_has_rentals(const HouseRow* h){
+    const IdList* l=multi_get(&landlord_rentals,h->landlord_id);
+    for(int i=0; l && i<l->len; i++){
+        const Rental* r=find_rental_by_id(l->ids[i]);
+        if(r && r->house_id==h->id) return true;
+    }
+    return false;
+}
+
+static bool user_has_rentals(const User* u){
+    const IdList* l=multi_get(&tenant_rentals,u->id);
+    return l && l->len>0;
+}
+
+static const char* rental_tenant(const Rental* r){
+    const User* u=find_user_by_id(r->tenant_id);
+    return u?user_str(u->full_name):departed_name(&departed_tenants,r->tenant_id);
+}
+
+static const char* rental_title(const Rental* r){
+    const HouseRow* h=find_house_by_id(r->house_id);
+    return h?house_str(house_text[h-houses].title):departed_name(&departed_titles,r->house_id);
+}
+
+// Overwrite the names a row was read with by the live ones where they exist.
+static void join_rental_names(const Rental* r, RentalNames* n){
+    const User* u=find_user_by_id(r->tenant_id);
+    const HouseRow* h=find_house_by_id(r->house_id);
+    if(u) snprintf(n->tenant,sizeof(n->tenant),"%s",user_str(u->full_name));
+    if(h) snprintf(n->title,sizeof(n->title),"%s",house_str(house_text[h-houses].title));
+}
+
+// ------------- Username Index -------------
+// Open-addressing map from username to user id. A bucket holds the name's
+// hash and the id; names are compared through find_user_by_id, so buckets
+// stay valid when remove_user_at shifts records down.
+typedef struct {
+    uint32_t* hashes;   // 0 = empty bucket
+    int* ids;
+    int  cap;           // power of two
+    int  count;
+} NameIndex;
+
+static NameIndex username_index;
+
+static uint32_t name_hash(const char* s){
+    uint32_t h=2166136261u;   // FNV-1a
+    while(*s){ h^=(unsigned char)*s++; h*=16777619u; }
+    return h?h:1;
+}
+
+static void name_idx_alloc(NameIndex* ix, int cap){
+    ix->hashes=calloc((size_t)cap,sizeof(uint32_t));
+    ix->ids=malloc((size_t)cap*sizeof(int));
+    if(!ix->hashes || !ix->ids){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    ix->cap=cap;
+    ix->count=0;
+}
+
+static void name_idx_grow(NameIndex* ix){
+    NameIndex old=*ix;
+    name_idx_alloc(ix,old.cap?old.cap*2:64);
+    unsigned mask=(unsigned)ix->cap-1;
+    for(int i=0;i<old.cap;i++){
+        if(!old.hashes[i]) continue;
+        unsigned j=old.hashes[i]&mask;
+        while(ix->hashes[j]) j=(j+1)&mask;
+        ix->hashes[j]=old.hashes[i];
+        ix->ids[j]=old.ids[i];
+        ix->count++;
+    }
+    free(old.hashes);
+    free(old.ids);
+}
+
+// Bucket holding name, or the empty bucket that ends its probe run.
+static unsigned name_idx_bucket(const NameIndex* ix, const char* name, uint32_t h){
+    unsigned mask=(unsigned)ix->cap-1, i=h&mask;
+    for(; ix->hashes[i]; i=(i+1)&mask){
+        if(ix->hashes[i]!=h) continue;
+        const User* u=find_user_by_id(ix->ids[i]);
+        if(u && strcmp(user_str(u->username),name)==0) break;
+    }
+    return i;
+}
+
+// The first user indexed under a name keeps it.
+static void name_idx_put(NameIndex* ix, const char* name, int id){
+    if((ix->count+1)*10>ix->cap*7) name_idx_grow(ix);
+    uint32_t h=name_hash(name);
+    unsigned i=name_idx_bucket(ix,name,h);
+    if(ix->hashes[i]) return;
+    ix->hashes[i]=h;
+    ix->ids[i]=id;
+    ix->count++;
+}
+
+static void name_idx_del(NameIndex* ix, const char* name, int id){
+    if(!ix->cap) return;
+    unsigned mask=(unsigned)ix->cap-1, i=name_idx_bucket(ix,name,name_hash(name));
+    if(!ix->hashes[i] || ix->ids[i]!=id) return;
+    for(unsigned j=(i+1)&mask; ix->hashes[j]; j=(j+1)&mask){
+        unsigned home=ix->hashes[j]&mask;
+        if(((j-home)&mask) >= ((j-i)&mask)){
+            ix->hashes[i]=ix->hashes[j];
+            ix->ids[i]=ix->ids[j];
+            i=j;
+        }
+    }
+    ix->hashes[i]=0;
+    ix->count--;
+}
+
+static void reindex_usernames(void){
+    if(username_index.cap) memset(username_index.hashes,0,(size_t)username_index.cap*sizeof(uint32_t));
+    username_index.count=0;
+    for(int i=0;i<user_count;i++) name_idx_put(&username_index,user_str(users[i].username),users[i].id);
+}
+
+static User* find_user_by_username(const char* name){
+    if(!username_index.cap) return NULL;
+    unsigned i=name_idx_bucket(&username_index,name,name_hash(name));
+    return username_index.hashes[i]?find_user_by_id(username_index.ids[i]):NULL;
+}
+
+// ------------- City/Area Facets -----------
+// Inverted index from normalized city and city+area to house ids, with a
+// running count of available houses per facet. Facet ids come from a string
+// dictionary that owns its keys; facets are never removed, empty ones are
+// just skipped when listing.
+typedef struct {
+    char**    keys;      // facet id -> normalized key
+    char**    labels;    // id -> spelling first seen, for display (may alias keys)
+    int       count, cap;
+    uint32_t* hashes;    // buckets; 0 = empty
+    int*      ids;
+    int       nbuckets;  // power of two
+} StrDict;
+
+typedef struct {
+    StrDict    dict;
+    MultiIndex houses;     // facet id -> house ids
+    int*       available;  // facet id -> available houses
+    int*       parent;     // area facet id -> city facet id
+} Facet;
+
+static Facet city_facet, area_facet;
+
+static char* copy_str(const char* s){
+    size_t n=strlen(s)+1;
+    char* p=malloc(n);
+    if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    return memcpy(p,s,n);
+}
+
+// Trim, fold ASCII case and collapse runs of whitespace to one space.
+static void normalize_key(char* dst, size_t cap, const char* src){
+    size_t n=0;
+    bool space=false;
+    for(; *src && n+1<cap; src++){
+        unsigned char c=(unsigned char)*src;
+        if(isspace(c)){ space=(n>0); continue; }
+        if(space && n+2<cap) dst[n++]=' ';
+        space=false;
+        dst[n++]=(char)tolower(c);
+    }
+    dst[n]='\0';
+}
+
+static int dict_find(const StrDict* d, const char* key, uint32_t h, unsigned* bucket){
+    if(!d->nbuckets){ *bucket=0; return -1; }
+    unsigned mask=(unsigned)d->nbuckets-1, i=h&mask;
+    for(; d->hashes[i]; i=(i+1)&mask)
+        if(d->hashes[i]==h && strcmp(d->keys[d->ids[i]],key)==0) break;
+    *bucket=i;
+    return d->hashes[i]?d->ids[i]:-1;
+}
+
+static void dict_rehash(StrDict* d){
+    int n=d->nbuckets?d->nbuckets*2:64;
+    uint32_t* hs=calloc((size_t)n,sizeof(uint32_t));
+    int* ids=malloc((size_t)n*sizeof(int));
+    if(!hs || !ids){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    for(int i=0;i<d->nbuckets;i++){
+        if(!d->hashes[i]) continue;
+        unsigned j=d->hashes[i]&(unsigned)(n-1);
+        while(hs[j]) j=(j+1)&(unsigned)(n-1);
+        hs[j]=d->hashes[i];
+        ids[j]=d->ids[i];
+    }
+    free(d->hashes);
+    free(d->ids);
+    d->hashes=hs;
+    d->ids=ids;
+    d->nbuckets=n;
+}
+
+// Id of key, adding it (with its display label) when it is new.
+static int dict_intern(StrDict* d, const char* key, const char* label, bool* added){
+    uint32_t h=name_hash(key);
+    unsigned b;
+    int id=dict_find(d,key,h,&b);
+    *added=(id<0);
+    if(id>=0) return id;
+    if((d->count+1)*10>d->nbuckets*7){
+        dict_rehash(d);
+        dict_find(d,key,h,&b);
+    }
+    if(d->count==d->cap){
+        int cap=d->cap?d->cap*2:64;
+        char** k=realloc(d->keys,(size_t)cap*sizeof(char*));
+        if(k) d->keys=k;
+        char** l=realloc(d->labels,(size_t)cap*sizeof(char*));
+        if(l) d->labels=l;
+        if(!k || !l){ fprintf(stderr,"Out of memory\n"); exit(1); }
+        d->cap=cap;
+    }
+    id=d->count++;
+    d->keys[id]=copy_str(key);
+    d->labels[id]=label?copy_str(label):d->keys[id];
+    d->hashes[b]=h;
+    d->ids[b]=id;
+    return id;
+}
+
+// ---------------- Symbols -----------------
+// Interning pool for the strings houses repeat: city, area and landlord
+// name. Each distinct string is stored once and records hold its symbol,
+// so equal strings are equal symbols. Symbols are never freed, and their
+// strings never move. The pool has one writer: the parallel house loader
+// interns into a dictionary per chunk and maps those into the pool once per
+// distinct string when it merges the chunks.
+static StrDict sym_pool;
+
+static Sym intern(const char* s){
+    bool added;
+    return dict_intern(&sym_pool,s,NULL,&added);
+}
+
+static void dict_free(StrDict* d){
+    for(int i=0;i<d->count;i++){
+        if(d->labels[i]!=d->keys[i]) free(d->labels[i]);
+        free(d->keys[i]);
+    }
+    free(d->keys);
+    free(d->labels);
+    free(d->hashes);
+    free(d->ids);
+    memset(d,0,sizeof(*d));
+}
+
+static const char* sym_str(Sym s){ return sym_pool.keys[s]; }
+
+static int facet_intern(Facet* f, const char* key, const char* label, int parent){
+    int old_cap=f->dict.cap;
+    bool added;
+    int id=dict_intern(&f->dict,key,label,&added);
+    if(!added) return id;
+    if(f->dict.cap!=old_cap){
+        int* a=realloc(f->available,(size_t)f->dict.cap*sizeof(int));
+        if(a) f->available=a;
+        int* p=realloc(f->parent,(size_t)f->dict.cap*sizeof(int));
+        if(p) f->parent=p;
+        if(!a || !p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    }
+    f->available[id]=0;
+    f->parent[id]=parent;
+    return id;
+}
+
+#define CITY_KEY_MAX 50
+#define AREA_KEY_MAX (CITY_KEY_MAX+51)
+
+// Area keys are "<city key>\x1f<normalized area>", so areas with the same
+// name in different cities stay apart.
+static void area_key(char* dst, const char* city_key, const char* area){
+    size_t n=strlen(city_key);
+    memcpy(dst,city_key,n);
+    dst[n]='\x1f';
+    normalize_key(dst+n+1,AREA_KEY_MAX-n-1,area);
+}
+
+// Intern the house's city, and its area within that city, into its row.
+static void facet_add(HouseRow* h){
+    const HouseText* t=text_of(h);
+    char c[CITY_KEY_MAX], a[AREA_KEY_MAX];
+    const char* city=sym_str(t->city_sym);
+    const char* area=sym_str(t->area_sym);
+    normalize_key(c,sizeof(c),city);
+    h->city=facet_intern(&city_facet,c,city,-1);
+    area_key(a,c,area);
+    h->area=facet_intern(&area_facet,a,area,h->city);
+    multi_add(&city_facet.houses,h->city,h->id);
+    multi_add(&area_facet.houses,h->area,h->id);
+    if(h->status==STATUS_AVAILABLE){
+        city_facet.available[h->city]++;
+        area_facet.available[h->area]++;
+    }
+}
+
+static void facet_del(const HouseRow* h){
+    multi_del(&city_facet.houses,h->city,h->id);
+    multi_del(&area_facet.houses,h->area,h->id);
+    if(h->status==STATUS_AVAILABLE){
+        city_facet.available[h->city]--;
+        area_facet.available[h->area]--;
+    }
+}
+
+// Status changes only move the available counts.
+static void facet_status(const HouseRow* h, HouseStatus from, HouseStatus to){
+    int delta=(to==STATUS_AVAILABLE)-(from==STATUS_AVAILABLE);
+    if(!delta) return;
+    city_facet.available[h->city]+=delta;
+    area_facet.available[h->area]+=delta;
+}
+
+static void reindex_facets(void){
+    Facet* fs[2]={&city_facet,&area_facet};
+    for(int k=0;k<2;k++){
+        multi_clear(&fs[k]->houses);
+        for(int i=0;i<fs[k]->dict.count;i++) fs[k]->available[i]=0;
+    }
+    for(int i=0;i<house_count;i++) facet_add(&houses[i]);
+}
+
+// ------------- Full-Text Index ------------
+// Inverted index over title, description, city and area. Tokens are runs of
+// letters, digits and non-ASCII bytes, with ASCII case folded. Each term has a
+// postings list of (house id, term frequency, house token count) in ascending
+// id order, so scoring never leaves the lists. The index is built by the first
+// search and kept current from then on; until then the hooks below do nothing,
+// so startup does not pay for it.
+#define TEXT_TERM_MAX       32    // longer tokens are cut
+#define TEXT_DOC_TERMS_MAX  512   // the four fields hold at most ~350 tokens
+#define TEXT_QUERY_TERMS    16
+#define BM25_K1             1.2
+#define BM25_B              0.75
+
+typedef struct { int id; uint16_t tf, len; } Posting;
+typedef struct { Posting* p; int len, cap; } PostingList;
+
+static struct {
+    bool         ready;
+    StrDict      terms;
+    PostingList* postings;    // term id -> postings
+    int          cap;
+    long long    total_len;
+    int          docs;
+} text_index;
+
+static bool is_token_char(unsigned char c){
+    return isalnum(c) || c>=0x80;
+}
+
+// Copy the next token at *p into tok (folded, cut to TEXT_TERM_MAX-1) and
+// advance *p past it; false at the end of the string.
+static bool next_token(const char** p, char* tok){
+    const unsigned char* s=(const unsigned char*)*p;
+    while(*s && !is_token_char(*s)) s++;
+    if(!*s){ *p=(const char*)s; return false; }
+    int n=0;
+    for(; is_token_char(*s); s++)
+        if(n<TEXT_TERM_MAX-1) tok[n++]=(char)((*s<0x80)?tolower(*s):*s);
+    tok[n]='\0';
+    *p=(const char*)s;
+    return true;
+}
+
+// Term ids of every token of the house, in field order; returns how many.
+// With add set, unseen terms are added to the dictionary, otherwise skipped.
+static int house_terms(const HouseText* h, int* ids, bool add){
+    const char* fields[4]={house_str(h->title),house_str(h->description),sym_str(h->city_sym),sym_str(h->area_sym)};
+    char tok[TEXT_TERM_MAX];
+    int n=0;
+    for(int f=0;f<4;f++){
+        const char* p=fields[f];
+        while(n<TEXT_DOC_TERMS_MAX && next_token(&p,tok)){
+            int id;
+            if(add){
+                bool added;
+                id=dict_intern(&text_index.terms,tok,NULL,&added);
+            } else {
+                unsigned b;
+                id=dict_find(&text_index.terms,tok,name_hash(tok),&b);
+            }
+            if(id>=0) ids[n++]=id;
+        }
+    }
+    return n;
+}
+
+static int cmp_int(const void* a, const void* b){
+    int x=*(const int*)a, y=*(const int*)b;
+    return (x>y)-(x<y);
+}
+
+// Position of id in the list at or after from, or where it would go. Gallops
+// forward first, so a sweep of ascending ids costs O(log gap) per step.
+static int posting_find(const PostingList* l, int from, int id){
+    int lo=from, hi=l->len, step=1;
+    while(lo+step<hi && l->p[lo+step].id<id){ lo+=step; step*=2; }
+    if(lo+step<hi) hi=lo+step+1;
+    while(lo<hi){
+        int mid=(lo+hi)/2;
+        if(l->p[mid].id<id) lo=mid+1; else hi=mid;
+    }
+    return lo;
+}
+
+static void posting_add(int term, int id, int tf, int len){
+    if(term>=text_index.cap){
+        int cap=text_index.cap?text_index.cap*2:1024;
+        while(cap<=term) cap*=2;
+        PostingList* p=realloc(text_index.postings,(size_t)cap*sizeof(PostingList));
+        if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+        memset(p+text_index.cap,0,(size_t)(cap-text_index.cap)*sizeof(PostingList));
+        text_index.postings=p;
+        text_index.cap=cap;
+    }
+    PostingList* l=&text_index.postings[term];
+    if(l->len==l->cap){
+        int cap=l->cap?l->cap*2:4;
+        Posting* p=realloc(l->p,(size_t)cap*sizeof(Posting));
+        if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+        l->p=p;
+        l->cap=cap;
+    }
+    int i=(l->len && l->p[l->len-1].id>id)?posting_find(l,0,id):l->len;   // new houses append
+    memmove(l->p+i+1,l->p+i,(size_t)(l->len-i)*sizeof(Posting));
+    l->p[i].id=id;
+    l->p[i].tf=(uint16_t)tf;
+    l->p[i].len=(uint16_t)len;
+    l->len++;
+}
+
+static void posting_del(int term, int id){
+    if(term>=text_index.cap) return;
+    PostingList* l=&text_index.postings[term];
+    int i=posting_find(l,0,id);
+    if(i==l->len || l->p[i].id!=id) return;
+    memmove(l->p+i,l->p+i+1,(size_t)(l->len-i-1)*sizeof(Posting));
+    l->len--;
+}
+
+static void text_add(const HouseRow* h){
+    if(!text_index.ready) return;
+    int ids[TEXT_DOC_TERMS_MAX];
+    int n=house_terms(text_of(h),ids,true);
+    qsort(ids,(size_t)n,sizeof(int),cmp_int);
+    for(int i=0,j;i<n;i=j){
+        for(j=i+1;j<n && ids[j]==ids[i];j++) {}
+        posting_add(ids[i],h->id,j-i,n);
+    }
+    text_index.total_len+=n;
+    text_index.docs++;
+}
+
+// The house must still hold the text it was indexed with.
+static void text_del(const HouseRow* h){
+    if(!text_index.ready) return;
+    int ids[TEXT_DOC_TERMS_MAX];
+    int n=house_terms(text_of(h),ids,false);
+    qsort(ids,(size_t)n,sizeof(int),cmp_int);
+    for(int i=0;i<n;i++)
+        if(i==0 || ids[i]!=ids[i-1]) posting_del(ids[i],h->id);
+    text_index.total_len-=n;
+    text_index.docs--;
+}
+
+static bool same_text(const HouseText* a, const House* b){
+    return strcmp(house_str(a->title),b->title)==0 && strcmp(house_str(a->description),b->description)==0 &&
+           strcmp(sym_str(a->city_sym),b->city)==0 && strcmp(sym_str(a->area_sym),b->area)==0;
+}
+
+static void text_build(void){
+    text_index.ready=true;
+    for(int i=0;i<house_count;i++) text_add(&houses[i]);
+}
+
+typedef struct { int id; double score; } TextHit;
+
+// Min-heap on score holding the best k hits seen so far.
+static void hit_push(TextHit* heap, int* n, int k, TextHit h){
+    if(*n==k){
+        if(h.score<=heap[0].score) return;
+        int i=0;
+        for(;;){   // replace the root and sift down
+            int c=2*i+1;
+            if(c>=k) break;
+            if(c+1<k && heap[c+1].score<heap[c].score) c++;
+            if(heap[c].score>=h.score) break;
+            heap[i]=heap[c];
+            i=c;
+        }
+        heap[i]=h;
+        return;
+    }
+    int i=(*n)++;
+    while(i>0 && heap[(i-1)/2].score>h.score){
+        heap[i]=heap[(i-1)/2];
+        i=(i-1)/2;
+    }
+    heap[i]=h;
+}
+
+static int cmp_hit_desc(const void* a, const void* b){
+    const TextHit* x=(const TextHit*)a;
+    const TextHit* y=(const TextHit*)b;
+    if(x->score!=y->score) return (x->score<y->score)?1:-1;
+    return (x->id>y->id)-(x->id<y->id);
+}
+
+// Houses containing every query term, best BM25 score first. Fills up to k
+// hits and returns how many were filled; *matched gets the number of houses,
+// of any status, that contain every term. With available_only, the status is
+// read only for matches that would enter the top k.
+static int text_search(const char* query, bool available_only, TextHit* hits, int k, long* matched){
+    if(!text_index.ready) text_build();
+    *matched=0;
+    int terms[TEXT_QUERY_TERMS], nt=0;
+    char tok[TEXT_TERM_MAX];
+    for(const char* p=query; nt<TEXT_QUERY_TERMS && next_token(&p,tok); ){
+        unsigned b;
+        int id=dict_find(&text_index.terms,tok,name_hash(tok),&b);
+        if(id<0 || id>=text_index.cap || !text_index.postings[id].len) return 0;   // AND: a missing term matches nothing
+        bool dup=false;
+        for(int i=0;i<nt;i++) dup|=(terms[i]==id);
+        if(!dup) terms[nt++]=id;
+    }
+    if(!nt) return 0;
+    // Drive the intersection from the rarest term.
+    for(int i=1;i<nt;i++)
+        for(int j=i;j>0 && text_index.postings[terms[j]].len<text_index.postings[terms[j-1]].len;j--){
+            int t=terms[j]; terms[j]=terms[j-1]; terms[j-1]=t;
+        }
+    const PostingList* lists[TEXT_QUERY_TERMS];
+    double idf[TEXT_QUERY_TERMS];
+    int pos[TEXT_QUERY_TERMS];
+    double N=text_index.docs, avgdl=text_index.docs?(double)text_index.total_len/text_index.docs:1.0;
+    for(int i=0;i<nt;i++){
+        lists[i]=&text_index.postings[terms[i]];
+        double df=lists[i]->len;
+        idf[i]=log(1.0+(N-df+0.5)/(df+0.5));
+        pos[i]=0;
+    }
+
+    int n=0;
+    for(int r=0;r<lists[0]->len;r++){
+        int id=lists[0]->p[r].id;
+        int tf[TEXT_QUERY_TERMS];
+        tf[0]=lists[0]->p[r].tf;
+        bool all=true;
+        for(int i=1;i<nt && all;i++){
+            pos[i]=posting_find(lists[i],pos[i],id);
+            all = pos[i]<lists[i]->len && lists[i]->p[pos[i]].id==id;
+            if(all) tf[i]=lists[i]->p[pos[i]].tf;
+        }
+        if(!all) continue;
+        (*matched)++;
+        double norm=BM25_K1*(1.0-BM25_B+BM25_B*lists[0]->p[r].len/avgdl);
+        TextHit h={id,0.0};
+        for(int i=0;i<nt;i++) h.score+=idf[i]*tf[i]*(BM25_K1+1.0)/(tf[i]+norm);
+        if(n==k && h.score<=hits[0].score) continue;
+        if(available_only && find_house_by_id(id)->status!=STATUS_AVAILABLE) continue;
+        hit_push(hits,&n,k,h);
+    }
+    qsort(hits,(size_t)n,sizeof(TextHit),cmp_hit_desc);
+    return n;
+}
+
+// ---------------- Records ------------------
+#define RECORD_LINE_MAX 2048   // longest formatted record (a House is ~1.2 KB)
+
+// One pipe-delimited line per record; shared by the table files and journals.
+// Lines are parsed in place (no NUL, no stdio) with the same acceptance rules
+// as the old "%d|%49[^|]|..." sscanf formats: a string field must be 1..width
+// chars and followed by '|', only the trailing %19[^\n] field truncates, and
+// numbers skip leading whitespace like %d/%lf do.
+#define LINE_MAX_BARS 16
+
+typedef struct {
+    const char* start;
+    const char* end;                   // the '\n' or the end of the buffer
+    const char* bars[LINE_MAX_BARS];   // '|' positions in [start,end), in order
+    int nbars;
+    bool more_bars;                    // bars[] overflowed; find the rest with memchr
+} LineScan;
+
+static unsigned ctz32(unsigned x){
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i,x);
+    return (unsigned)i;
+#else
+    return (unsigned)__builtin_ctz(x);
+#endif
+}
+
+static void scan_add_bars(LineScan* ls, const char* base, unsigned mask){
+    while(mask){
+        if(ls->nbars==LINE_MAX_BARS){ ls->more_bars=true; return; }
+        ls->bars[ls->nbars++]=base+ctz32(mask);
+        mask&=mask-1;
+    }
+}
+
+// Find the end of the line at p and every '|' before it, 32 (AVX2) or 16
+// (SSE2) bytes per step, finishing byte by byte.
+static void scan_line(const char* p, const char* end, LineScan* ls){
+    ls->start=p;
+    ls->nbars=0;
+    ls->more_bars=false;
+#if defined(__AVX2__)
+    const __m256i bar32=_mm256_set1_epi8('|'), nl32=_mm256_set1_epi8('\n');
+    while(end-p>=32){
+        __m256i v=_mm256_loadu_si256((const __m256i*)p);
+        unsigned bars=(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v,bar32));
+        unsigned nls =(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v,nl32));
+        if(nls){
+            unsigned at=ctz32(nls);
+            scan_add_bars(ls,p,bars&((1u<<at)-1));
+            ls->end=p+at;
+            return;
+        }
+        scan_add_bars(ls,p,bars);
+        p+=32;
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    const __m128i bar16=_mm_set1_epi8('|'), nl16=_mm_set1_epi8('\n');
+    while(end-p>=16){
+        __m128i v=_mm_loadu_si128((const __m128i*)p);
+        unsigned bars=(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v,bar16));
+        unsigned nls =(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v,nl16));
+        if(nls){
+            unsigned at=ctz32(nls);
+            scan_add_bars(ls,p,bars&((1u<<at)-1));
+            ls->end=p+at;
+            return;
+        }
+        scan_add_bars(ls,p,bars);
+        p+=16;
+    }
+#endif
+    for(; p<end && *p!='\n'; p++){
+        if(*p=='|') scan_add_bars(ls,p,1u);
+    }
+    ls->end=p;
+}
+
+typedef struct { const char* p; const LineScan* ls; int bar; } Fields;
+
+static bool is_scan_space(char c){
+    return c==' ' || c=='\t' || c=='\n' || c=='\v' || c=='\f' || c=='\r';
+}
+
+static const char* next_bar(Fields* f){
+    const LineScan* ls=f->ls;
+    while(f->bar<ls->nbars && ls->bars[f->bar]<f->p) f->bar++;
+    if(f->bar<ls->nbars) return ls->bars[f->bar];
+    if(!ls->more_bars) return NULL;
+    return memchr(f->p,'|',(size_t)(ls->end-f->p));
+}
+
+static bool field_str(Fields* f, char* dst, size_t cap){
+    const char* bar=next_bar(f);
+    if(!bar) return false;
+    size_t len=(size_t)(bar-f->p);
+    if(len==0 || len>cap-1) return false;
+    memcpy(dst,f->p,len);
+    dst[len]='\0';
+    f->p=bar+1;
+    return true;
+}
+
+static bool field_tail(Fields* f, char* dst, size_t cap){
+    size_t len=(size_t)(f->ls->end-f->p);
+    if(len==0) return false;
+    if(len>cap-1) len=cap-1;
+    memcpy(dst,f->p,len);
+    dst[len]='\0';
+    f->p+=len;
+    return true;
+}
+
+// last=false: the number must be followed by '|', which is consumed.
+static bool field_int(Fields* f, int* out, bool last){
+    const char* p=f->p;
+    const char* end=f->ls->end;
+    while(p<end && is_scan_space(*p)) p++;
+    bool neg=false;
+    if(p<end && (*p=='-' || *p=='+')) neg=(*p++=='-');
+    const char* digits=p;
+    unsigned long long v=0;
+    while(p<end && *p>='0' && *p<='9') v=v*10+(unsigned)(*p++-'0');
+    if(p==digits) return false;
+    if(!last){
+        if(p>=end || *p!='|') return false;
+        p++;
+    }
+    *out=(int)(neg?0-v:v);
+    f->p=p;
+    return true;
+}
+
+// Plain "[-]ddd.dd" with at most 15 digits is mantissa/10^k, which is exact
+// in both operands and therefore rounds the same as strtod. Anything else
+// (exponents, hex, inf/nan, long digit runs) goes through strtod.
+static const double pow10_table[]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,
+                                   1e11,1e12,1e13,1e14,1e15};
+
+static bool fast_decimal(const char* p, const char* end, double* out, const char** stop){
+    bool neg=false;
+    if(p<end && (*p=='-' || *p=='+')) neg=(*p++=='-');
+    unsigned long long m=0;
+    int ndig=0, frac=0;
+    while(p<end && *p>='0' && *p<='9'){ m=m*10+(unsigned)(*p++-'0'); ndig++; }
+    if(p<end && *p=='.'){
+        p++;
+        while(p<end && *p>='0' && *p<='9'){ m=m*10+(unsigned)(*p++-'0'); ndig++; frac++; }
+    }
+    if(ndig==0 || ndig>15) return false;
+    if(p<end && (*p=='e' || *p=='E' || *p=='x' || *p=='X')) return false;
+    double v=(double)m/pow10_table[frac];
+    *out=neg?-v:v;
+    *stop=p;
+    return true;
+}
+
+static bool field_double(Fields* f, double* out, bool last){
+    const char* p=f->p;
+    const char* end=f->ls->end;
+    while(p<end && is_scan_space(*p)) p++;
+    double v;
+    const char* stop;
+    if(!fast_decimal(p,end,&v,&stop)){
+        char buf[64];
+        size_t n=0;
+        while(p+n<end && p[n]!='|' && n<sizeof(buf)-1){ buf[n]=p[n]; n++; }
+        buf[n]='\0';
+        char* bstop;
+        v=strtod(buf,&bstop);
+        if(bstop==buf) return false;
+        stop=p+(bstop-buf);
+    }
+    p=stop;
+    if(!last){
+        if(p>=end || *p!='|') return false;
+        p++;
+    }
+    *out=v;
+    f->p=p;
+    return true;
+}
+
+static bool parse_user(const LineScan* ls, User* u){
+    Fields f={ls->start,ls,0};
+    int role, active;
+    char username[USERNAME_MAX], password[PASSWORD_MAX], full_name[FULL_NAME_MAX];
+    char email[EMAIL_MAX], phone[PHONE_MAX];
+    if(!(field_int(&f,&u->id,false) && field_str(&f,username,sizeof(username)) &&
+         field_str(&f,password,sizeof(password)) && field_str(&f,full_name,sizeof(full_name)) &&
+         field_str(&f,email,sizeof(email)) && field_str(&f,phone,sizeof(phone)) &&
+         field_int(&f,&role,false) && field_int(&f,&active,true)))
+        return false;
+    user_set_text(u,username,password,full_name,email,phone);
+    u->role=(UserRole)role;
+    u->is_active=(bool)active;
+    return true;
+}
+
+static int format_user(char* buf, size_t n, const User* u){
+    return snprintf(buf,n,"%d|%s|%s|%s|%s|%s|%d|%d\n",
+        u->id,user_str(u->username),user_str(u->password),user_str(u->full_name),
+        user_str(u->email),user_str(u->phone),u->role,u->is_active);
+}
+
+static bool parse_house(const LineScan* ls, House* h){
+    Fields f={ls->start,ls,0};
+    int status;
+    if(!(field_int(&f,&h->id,false) && field_str(&f,h->title,sizeof(h->title)) &&
+         field_str(&f,h->address,sizeof(h->address)) && field_str(&f,h->city,sizeof(h->city)) &&
+         field_str(&f,h->area,sizeof(h->area)) && field_int(&f,&h->bedrooms,false) &&
+         field_int(&f,&h->bathrooms,false) && field_double(&f,&h->rent,false) &&
+         field_str(&f,h->description,sizeof(h->description)) && field_int(&f,&h->landlord_id,false) &&
+         field_str(&f,h->landlord_name,sizeof(h->landlord_name)) && field_int(&f,&status,false) &&
+         field_tail(&f,h->date_added,sizeof(h->date_added))))
+        return false;
+    h->status=(HouseStatus)status;
+    h->rent=round_rent(h->rent);
+    return true;
+}
+
+static int format_house(char* buf, size_t n, const HouseRow* h){
+    const HouseText* t=text_of(h);
+    return snprintf(buf,n,"%d|%s|%s|%s|%s|%d|%d|%.2f|%s|%d|%s|%d|%s\n",
+        h->id,house_str(t->title),house_str(t->address),sym_str(t->city_sym),sym_str(t->area_sym),h->bedrooms,
+        h->bathrooms,h->rent,house_str(t->description),h->landlord_id,sym_str(t->landlord_sym),h->status,
+        t->date_added);
+}
+
+// The names written with a rental go to n; they only matter for ids that
+// are gone.
+static bool parse_rental(const LineScan* ls, Rental* r, RentalNames* n){
+    Fields f={ls->start,ls,0};
+    int active;
+    if(!(field_int(&f,&r->id,false) && field_int(&f,&r->house_id,false) &&
+         field_int(&f,&r->tenant_id,false) && field_int(&f,&r->landlord_id,false) &&
+         field_str(&f,n->tenant,sizeof(n->tenant)) && field_str(&f,n->title,sizeof(n->title)) &&
+         field_str(&f,r->rental_date,sizeof(r->rental_date)) &&
+         field_double(&f,&r->monthly_rent,false) && field_int(&f,&active,true)))
+        return false;
+    r->is_active=(bool)active;
+    return true;
+}
+
+static int format_rental(char* buf, size_t n, const Rental* r){
+    return snprintf(buf,n,"%d|%d|%d|%d|%s|%s|%s|%.2f|%d\n",
+        r->id,r->house_id,r->tenant_id,r->landlord_id,rental_tenant(r),
+        rental_title(r),r->rental_date,r->monthly_rent,r->is_active);
+}
+
+// Append a record, growing its table, and index it.
+static User* add_user(const User* u){
+    reserve_users(user_count+1);
+    idx_put(&user_index,u->id,user_count);
+    track_id_order(TABLE_USERS,user_count,u->id,user_count?users[user_count-1].id:0);
+    users[user_count]=*u;
+    user_arena.live+=user_text_bytes(u);
+    seq_observe(TABLE_USERS,u->id);
+    name_idx_put(&username_index,user_str(u->username),u->id);
+    return &users[user_count++];
+}
+
+static HouseRow* add_house(const House* h){
+    reserve_houses(house_count+1);
+    idx_put(&house_index,h->id,house_count);
+    track_id_order(TABLE_HOUSES,house_count,h->id,house_count?houses[house_count-1].id:0);
+    house_store(house_count,h);
+    seq_observe(TABLE_HOUSES,h->id);
+    index_house_status(house_count,true);
+    facet_add(&houses[house_count]);
+    text_add(&houses[house_count]);
+    rent_insert(h->rent,h->id);
+    multi_add(&landlord_houses,h->landlord_id,h->id);
+    return &houses[house_count++];
+}
+
+static Rental* add_rental(const Rental* r){
+    reserve_rentals(rental_count+1);
+    idx_put(&rental_index,r->id,rental_count);
+    track_id_order(TABLE_RENTALS,rental_count,r->id,rental_count?rentals[rental_count-1].id:0);
+    rentals[rental_count]=*r;
+    seq_observe(TABLE_RENTALS,r->id);
+    index_rental(r);
+    return &rentals[rental_count++];
+}
+
+// Insert-or-replace by id; used by the loaders' journal replay.
+static void upsert_user(const User* u){
+    User* cur=find_user_by_id(u->id);
+    if(!cur){ add_user(u); return; }
+    user_arena.live-=user_text_bytes(cur);
+    user_arena.live+=user_text_bytes(u);
+    if(strcmp(user_str(cur->username),user_str(u->username))!=0){
+        name_idx_del(&username_index,user_str(cur->username),cur->id);
+        *cur=*u;
+        name_idx_put(&username_index,user_str(cur->username),cur->id);
+    }
+    else *cur=*u;
+    if(arena_wasteful(&user_arena)) compact_user_text();
+}
+
+// Overwrite a house in place (same id) and move it in every index.
+static void replace_house(HouseRow* cur, const House* h){
+    int slot=(int)(cur-houses);
+    if(cur->landlord_id!=h->landlord_id){
+        multi_del(&landlord_houses,cur->landlord_id,cur->id);
+        multi_add(&landlord_houses,h->landlord_id,h->id);
+    }
+    if(rent_key(cur->rent)!=rent_key(h->rent)){
+        rent_delete(cur->rent,cur->id);
+        rent_insert(h->rent,h->id);
+    }
+    bool text=!same_text(text_of(cur),h);
+    if(text) text_del(cur);
+    facet_del(cur);
+    index_house_status(slot,false);
+    house_release(slot);
+    house_store(slot,h);
+    index_house_status(slot,true);
+    facet_add(cur);
+    if(text) text_add(cur);
+    if(arena_wasteful(&house_arena)) compact_house_text();
+}
+
+static void upsert_house(const House* h){
+    HouseRow* cur=find_house_by_id(h->id);
+    if(cur) replace_house(cur,h);
+    else add_house(h);
+}
+
+// Every status change goes through here so the status bitmaps stay exact.
+static void set_house_status(HouseRow* h, HouseStatus st){
+    int slot=(int)(h-houses);
+    facet_status(h,h->status,st);
+    index_house_status(slot,false);
+    h->status=st;
+    house_cols.status[slot]=(uint8_t)st;
+    index_house_status(slot,true);
+}
+
+static void upsert_rental(const Rental* r){
+    Rental* cur=find_rental_by_id(r->id);
+    if(cur){
+        unindex_rental_active(cur);
+        if(cur->landlord_id!=r->landlord_id){
+            multi_del(&landlord_rentals,cur->landlord_id,cur->id);
+            multi_add(&landlord_rentals,r->landlord_id,r->id);
+        }
+        if(cur->tenant_id!=r->tenant_id){
+            multi_del(&tenant_rentals,cur->tenant_id,cur->id);
+            multi_add(&tenant_rentals,r->tenant_id,r->id);
+        }
+        *cur=*r;
+        index_rental_active(cur);
+    }
+    else add_rental(r);
+}
+
+// Removal keeps array order, so every later record moves down one slot.
+static void remove_user_at(int idx){
+    if(user_has_rentals(&users[idx]))
+        departed_put(&departed_tenants,users[idx].id,user_str(users[idx].full_name));
+    name_idx_del(&username_index,user_str(users[idx].username),users[idx].id);
+    idx_del(&user_index,users[idx].id);
+    user_arena.live-=user_text_bytes(&users[idx]);
+    for(int i=idx;i<user_count-1;i++){
+        users[i]=users[i+1];
+        idx_put(&user_index,users[i].id,i);
+    }
+    user_count--;
+    if(arena_wasteful(&user_arena)) compact_user_text();
+}
+
+static void remove_house_at(int idx){
+    if(house_has_rentals(&houses[idx]))
+        departed_put(&departed_titles,houses[idx].id,house_str(house_text[idx].title));
+    text_del(&houses[idx]);
+    facet_del(&houses[idx]);
+    rent_delete(houses[idx].rent,houses[idx].id);
+    multi_del(&landlord_houses,houses[idx].landlord_id,houses[idx].id);
+    idx_del(&house_index,houses[idx].id);
+    for(int s=0;s<STATUS_COUNT;s++) bitmap_remove_at(&status_bits[s],idx,house_count);
+    house_release(idx);
+    memmove(&house_text[idx],&house_text[idx+1],(size_t)(house_count-idx-1)*sizeof(HouseText));
+    house_cols_move(idx,idx+1,house_count-idx-1);
+    for(int i=idx;i<house_count-1;i++){
+        houses[i]=houses[i+1];
+        idx_put(&house_index,houses[i].id,i);
+    }
+    house_count--;
+    if(arena_wasteful(&house_arena)) compact_house_text();
+}
+
+static void remove_rental_at(int idx){
+    unindex_rental(&rentals[idx]);
+    idx_del(&rental_index,rentals[idx].id);
+    for(int i=idx;i<rental_count-1;i++){
+        rentals[i]=rentals[i+1];
+        idx_put(&rental_index,rentals[i].id,i);
+    }
+    rental_count--;
+}
+
+// ---------------- File I/O -----------------
+// The binary snapshot (or the text tables, when they are newer) is the base
+// state; every mutation since the last snapshot is appended to the table's
+// journal as "<op>|<record>" (I/U) or "D|<id>".
+static const char* const journal_files[TABLE_COUNT] = { USERS_JOURNAL, HOUSES_JOURNAL, RENTALS_JOURNAL };
+static int journal_pending[TABLE_COUNT];
+
+// Read-only view of a whole file; the loaders tokenize it in place.
+typedef struct {
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file, map;
+#endif
+} MappedFile;
+
+static bool map_file(const char* path, MappedFile* mf){
+    memset(mf, 0, sizeof(*mf));
+#ifdef _WIN32
+    mf->file=CreateFileA(path,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,
+                         FILE_FLAG_SEQUENTIAL_SCAN,NULL);
+    if(mf->file==INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER sz;
+    if(!GetFileSizeEx(mf->file,&sz)){ CloseHandle(mf->file); return false; }
+    mf->size=(size_t)sz.QuadPart;
+    if(mf->size==0) return true;   // empty files cannot be mapped
+    mf->map=CreateFileMappingA(mf->file,NULL,PAGE_READONLY,0,0,NULL);
+    if(!mf->map){ CloseHandle(mf->file); return false; }
+    mf->data=(const char*)MapViewOfFile(mf->map,FILE_MAP_READ,0,0,0);
+    if(!mf->data){ CloseHandle(mf->map); CloseHandle(mf->file); return false; }
+#else
+    int fd=open(path,O_RDONLY);
+    if(fd<0) return false;
+    struct stat st;
+    if(fstat(fd,&st)!=0){ close(fd); return false; }
+    mf->size=(size_t)st.st_size;
+    if(mf->size>0){
+        void* m=mmap(NULL,mf->size,PROT_READ,MAP_PRIVATE,fd,0);
+        if(m==MAP_FAILED){ close(fd); return false; }
+        madvise(m,mf->size,MADV_SEQUENTIAL);
+        mf->data=(const char*)m;
+    }
+    close(fd);   // the mapping keeps the file referenced
+#endif
+    return true;
+}
+
+static void unmap_file(MappedFile* mf){
+#ifdef _WIN32
+    if(mf->data) UnmapViewOfFile(mf->data);
+    if(mf->map) CloseHandle(mf->map);
+    if(mf->file && mf->file!=INVALID_HANDLE_VALUE) CloseHandle(mf->file);
+#else
+    if(mf->data) munmap((void*)mf->data,mf->size);
+#endif
+    mf->data=NULL;
+    mf->size=0;
+}
+
+static bool replace_file(const char* tmp, const char* dst){
+#ifdef _WIN32
+    remove(dst);   // rename() does not overwrite on Windows
+#endif
+    return rename(tmp,dst)==0;
+}
+
+static void load_users(void){
+    MappedFile mf;
+    if(!map_file(USERS_FILE,&mf)) return;
+    const char* end=mf.data+mf.size;
+    for(const char* p=mf.data; p<end; ){
+        LineScan ls;
+        scan_line(p,end,&ls);
+        reserve_users(user_count+1);
+        if(parse_user(&ls,&users[user_count])) user_arena.live+=user_text_bytes(&users[user_count++]);
+        p=(ls.end<end)?ls.end+1:end;
+    }
+    unmap_file(&mf);
+}
+
+static bool save_users(void){
+    FILE* fp=fopen(USERS_FILE ".tmp","w");
+    if(!fp) return false;
+    char line[RECORD_LINE_MAX];
+    for(int i=0;i<user_count;i++){
+        format_user(line,sizeof(line),&users[i]);
+        fputs(line,fp);
+    }
+    if(fclose(fp)!=0) return false;
+    return replace_file(USERS_FILE ".tmp",USERS_FILE);
+}
+
+// Large files are split into line-aligned chunks, one per core. Each chunk's
+// first slot is the number of lines before it, so workers parse straight into
+// the house slots without overlapping; gaps left by rejected lines are closed in
+// file order afterwards.
+// Each chunk keeps its text and symbols to itself while parsing; they move
+// into house_arena and the symbol pool when the chunks are merged.
+typedef struct {
+    const char* begin;
+    const char* end;
+    int lines;       // upper bound on records in the chunk
+    int first_slot;
+    int parsed;
+    Arena   text;
+    StrDict syms;    // chunk-local symbols
+} HouseChunk;
+
+static THREAD_FUNC count_chunk_lines(void* arg){
+    HouseChunk* c=(HouseChunk*)arg;
+    int n=0;
+    for(const char* p=c->begin; p<c->end; n++){
+        const char* nl=memchr(p,'\n',(size_t)(c->end-p));
+        p=nl?nl+1:c->end;
+    }
+    c->lines=n;
+    return 0;
+}
+
+// house_store() into the chunk's own arena and symbols.
+static void chunk_store(HouseChunk* c, int slot, const House* h){
+    HouseText* t=&house_text[slot];
+    bool added;
+    house_store_row(slot,h);
+    t->title=arena_put(&c->text,h->title);
+    t->address=arena_put(&c->text,h->address);
+    t->description=arena_put(&c->text,h->description);
+    c->text.live+=house_text_bytes(t);
+    t->city_sym=dict_intern(&c->syms,h->city,NULL,&added);
+    t->area_sym=dict_intern(&c->syms,h->area,NULL,&added);
+    t->landlord_sym=dict_intern(&c->syms,h->landlord_name,NULL,&added);
+}
+
+static THREAD_FUNC parse_house_chunk(void* arg){
+    HouseChunk* c=(HouseChunk*)arg;
+    int slot=c->first_slot;
+    for(const char* p=c->begin; p<c->end; ){
+        LineScan ls;
+        scan_line(p,c->end,&ls);
+        House h;
+        if(parse_house(&ls,&h)) chunk_store(c,slot++,&h);
+        p=(ls.end<c->end)?ls.end+1:c->end;
+    }
+    c->parsed=slot-c->first_slot;
+    return 0;
+}
+
+static void rebase_str(Str* s, uint32_t base){ if(s->len) s->off+=base; }
+
+// Move a parsed chunk's text and symbols into the shared stores; its records
+// already sit at slots [house_count, house_count+parsed).
+static void merge_chunk(HouseChunk* c){
+    arena_reserve(&house_arena,c->text.len);
+    uint32_t base=(uint32_t)house_arena.len;
+    if(c->text.len) memcpy(house_arena.data+base,c->text.data,c->text.len);
+    house_arena.len+=c->text.len;
+    house_arena.live+=c->text.live;
+    Sym* map=malloc((size_t)(c->syms.count?c->syms.count:1)*sizeof(Sym));
+    if(!map){ fprintf(stderr,"Out of memory\n"); exit(1); }
+    for(int i=0;i<c->syms.count;i++) map[i]=intern(c->syms.keys[i]);
+    for(int i=house_count;i<house_count+c->parsed;i++){
+        HouseText* t=&house_text[i];
+        rebase_str(&t->title,base);
+        rebase_str(&t->address,base);
+        rebase_str(&t->description,base);
+        t->city_sym=map[t->city_sym];
+        t->area_sym=map[t->area_sym];
+        t->landlord_sym=map[t->landlord_sym];
+    }
+    free(map);
+    free(c->text.data);
+    dict_free(&c->syms);
+}
+
+// Run fn over every chunk, one thread each; falls back to inline calls.
+static void run_chunks(HouseChunk* chunks, int n, THREAD_FUNC (*fn)(void*)){
+    Thread th[LOAD_MAX_THREADS];
+    bool started[LOAD_MAX_THREADS];
+    for(int i=0;i<n;i++){
+        started[i]=thread_start(&th[i],fn,&chunks[i]);
+        if(!started[i]) fn(&chunks[i]);
+    }
+    for(int i=0;i<n;i++) if(started[i]) thread_join(th[i]);
+}
+
+static void load_houses_file(const char* path){
+    MappedFile mf;
+    if(!map_file(path,&mf)) return;
+    const char* end=mf.data+mf.size;
+    int n = (mf.size>=PARALLEL_LOAD_BYTES)?cpu_count():1;
+    if(n>LOAD_MAX_THREADS) n=LOAD_MAX_THREADS;
+
+    HouseChunk chunks[LOAD_MAX_THREADS];
+    int nchunks=0;
+    for(const char* p=mf.data; p<end && nchunks<n; nchunks++){
+        const char* cut = (nchunks==n-1)?end:p+(size_t)(end-p)/(size_t)(n-nchunks);
+        if(cut<end){
+            const char* nl=memchr(cut,'\n',(size_t)(end-cut));
+            cut=nl?nl+1:end;
+        }
+        memset(&chunks[nchunks],0,sizeof(HouseChunk));
+        chunks[nchunks].begin=p;
+        chunks[nchunks].end=cut;
+        p=cut;
+    }
+    run_chunks(chunks,nchunks,count_chunk_lines);
+    int total=0;
+    for(int i=0;i<nchunks;i++){
+        chunks[i].first_slot=house_count+total;
+        total+=chunks[i].lines;
+    }
+
+    reserve_houses(house_count+total);
+    if(nchunks>1){
+        run_chunks(chunks,nchunks,parse_house_chunk);
+        for(int i=0;i<nchunks;i++){
+            if(chunks[i].first_slot!=house_count){
+                memmove(&houses[house_count],&houses[chunks[i].first_slot],
+                        (size_t)chunks[i].parsed*sizeof(HouseRow));
+                memmove(&house_text[house_count],&house_text[chunks[i].first_slot],
+                        (size_t)chunks[i].parsed*sizeof(HouseText));
+                house_cols_move(house_count,chunks[i].first_slot,chunks[i].parsed);
+            }
+            merge_chunk(&chunks[i]);
+            house_count+=chunks[i].parsed;
+        }
+    } else {
+        for(const char* p=mf.data; p<end; ){
+            LineScan ls;
+            scan_line(p,end,&ls);
+            House h;
+            if(parse_house(&ls,&h)) house_store(house_count++,&h);
+            p=(ls.end<end)?ls.end+1:end;
+        }
+    }
+    unmap_file(&mf);
+}
+
+static void load_houses(void){ load_houses_file(HOUSES_FILE); }
+
+static bool save_houses(void){
+    FILE* fp=fopen(HOUSES_FILE ".tmp","w");
+    if(!fp) return false;
+    char line[RECORD_LINE_MAX];
+    for(int i=0;i<house_count;i++){
+        format_house(line,sizeof(line),&houses[i]);
+        fputs(line,fp);
+    }
+    if(fclose(fp)!=0) return false;
+    return replace_file(HOUSES_FILE ".tmp",HOUSES_FILE);
+}
+
+static void load_rentals(void){
+    MappedFile mf;
+    if(!map_file(RENTALS_FILE,&mf)) return;
+    const char* end=mf.data+mf.size;
+    for(const char* p=mf.data; p<end; ){
+        LineScan ls;
+        scan_line(p,end,&ls);
+        reserve_rentals(rental_count+1);
+        RentalNames n;
+        if(parse_rental(&ls,&rentals[rental_count],&n)){
+            note_departed(&rentals[rental_count],&n);
+            rental_count++;
+        }
+        p=(ls.end<end)?ls.end+1:end;
+    }
+    unmap_file(&mf);
+}
+
+static bool save_rentals(void){
+    FILE* fp=fopen(RENTALS_FILE ".tmp","w");
+    if(!fp) return false;
+    char line[RECORD_LINE_MAX];
+    for(int i=0;i<rental_count;i++){
+        format_rental(line,sizeof(line),&rentals[i]);
+        fputs(line,fp);
+    }
+    if(fclose(fp)!=0) return false;
+    return replace_file(RENTALS_FILE ".tmp",RENTALS_FILE);
+}
+
+// ---------------- Snapshot -----------------
+// rental.hrs layout, all integers little-endian:
+//   "HRSN" | u32 version | u32 count[3] | u64 offset[3] | u32 id_seq[3]
+// (56-byte header; version 1 files end at the offsets, 44 bytes) followed by
+// the user, house and rental tables. Records store ints as u32, doubles as
+// their IEEE-754 bits and strings as u16 length + bytes.
+#define SNAPSHOT_HEADER_SIZE    56
+#define SNAPSHOT_V1_HEADER_SIZE 44
+
+typedef struct { char* data; size_t len, cap; } ByteBuf;
+
+static void buf_put(ByteBuf* b, const void* src, size_t n){
+    if(!n) return;
+    if(b->len+n>b->cap){
+        size_t cap=b->cap?b->cap:4096;
+        while(cap<b->len+n) cap*=2;
+        char* p=realloc(b->data,cap);
+        if(!p){ fprintf(stderr,"Out of memory\n"); exit(1); }
+        b->data=p;
+        b->cap=cap;
+    }
+    memcpy(b->data+b->len,src,n);
+    b->len+=n;
+}
+
+static void buf_u32(ByteBuf* b, uint32_t v){
+    unsigned char le[4]={(unsigned char)v,(unsigned char)(v>>8),(unsigned char)(v>>16),(unsigned char)(v>>24)};
+    buf_put(b,le,4);
+}
+
+static void buf_u64(ByteBuf* b, uint64_t v){
+    buf_u32(b,(uint32_t)v);
+    buf_u32(b,(uint32_t)(v>>32));
+}
+
+static void buf_f64(ByteBuf* b, double d){
+    uint64_t v;
+    memcpy(&v,&d,sizeof(v));
+    buf_u64(b,v);
+}
+
+static void buf_str(ByteBuf* b, const char* s){
+    size_t n=strlen(s);
+    unsigned char le[2]={(unsigned char)n,(unsigned char)(n>>8)};
+    buf_put(b,le,2);
+    buf_put(b,s,n);
+}
+
+typedef struct { const unsigned char* p; const unsigned char* end; bool ok; } ByteReader;
+
+static uint32_t rd_u32(ByteReader* r){
+    if(r->end-r->p<4){ r->ok=false; return 0; }
+    uint32_t v=(uint32_t)r->p[0]|(uint32_t)r->p[1]<<8|(uint32_t)r->p[2]<<16|(uint32_t)r->p[3]<<24;
+    r->p+=4;
+    return v;
+}
+
+static uint64_t rd_u64(ByteReader* r){
+    uint64_t lo=rd_u32(r);
+    return lo|(uint64_t)rd_u32(r)<<32;
+}
+
+static double rd_f64(ByteReader* r){
+    uint64_t v=rd_u64(r);
+    double d;
+    memcpy(&d,&v,sizeof(d));
+    return d;
+}
+
+static void rd_str(ByteReader* r, char* dst, size_t cap){
+    dst[0]='\0';
+    if(r->end-r->p<2){ r->ok=false; return; }
+    size_t n=(size_t)r->p[0]|(size_t)r->p[1]<<8;
+    r->p+=2;
+    if((size_t)(r->end-r->p)<n){ r->ok=false; return; }
+    size_t keep=(n<cap)?n:cap-1;
+    memcpy(dst,r->p,keep);
+    dst[keep]='\0';
+    r->p+=n;
+}
+
+static void encode_user(ByteBuf* b, const User* u){
+    buf_u32(b,(uint32_t)u->id);
+    buf_str(b,user_str(u->username)); buf_str(b,user_str(u->password));
+    buf_str(b,user_str(u->full_name)); buf_str(b,user_str(u->email));
+    buf_str(b,user_str(u->phone));
+    buf_u32(b,(uint32_t)u->role);
+    buf_u32(b,u->is_active);
+}
+
+static void decode_user(ByteReader* r, User* u){
+    char username[USERNAME_MAX], password[PASSWORD_MAX], full_name[FULL_NAME_MAX];
+    char email[EMAIL_MAX], phone[PHONE_MAX];
+    u->id=(int)rd_u32(r);
+    rd_str(r,username,sizeof(username)); rd_str(r,password,sizeof(password));
+    rd_str(r,full_name,sizeof(full_name)); rd_str(r,email,sizeof(email));
+    rd_str(r,phone,sizeof(phone));
+    user_set_text(u,username,password,full_name,email,phone);
+    u->role=(UserRole)rd_u32(r);
+    u->is_active=rd_u32(r)!=0;
+}
+
+static void encode_house(ByteBuf* b, const HouseRow* h){
+    const HouseText* t=text_of(h);
+    buf_u32(b,(uint32_t)h->id);
+    buf_str(b,house_str(t->title)); buf_str(b,house_str(t->address));
+    buf_str(b,sym_str(t->city_sym)); buf_str(b,sym_str(t->area_sym));
+    buf_u32(b,(uint32_t)h->bedrooms);
+    buf_u32(b,(uint32_t)h->bathrooms);
+    buf_f64(b,h->rent);
+    buf_str(b,house_str(t->description));
+    buf_u32(b,(uint32_t)h->landlord_id);
+    buf_str(b,sym_str(t->landlord_sym));
+    buf_u32(b,(uint32_t)h->status);
+    buf_str(b,t->date_added);
+}
+
+static void decode_house(ByteReader* r, House* h){
+    h->id=(int)rd_u32(r);
+    rd_str(r,h->title,sizeof(h->title)); rd_str(r,h->address,sizeof(h->address));
+    rd_str(r,h->city,sizeof(h->city));   rd_str(r,h->area,sizeof(h->area));
+    h->bedrooms=(int)rd_u32(r);
+    h->bathrooms=(int)rd_u32(r);
+    h->rent=rd_f64(r);
+    rd_str(r,h->description,sizeof(h->description));
+    h->landlord_id=(int)rd_u32(r);
+    rd_str(r,h->landlord_name,sizeof(h->landlord_name));
+    h->status=(HouseStatus)rd_u32(r);
+    rd_str(r,h->date_added,sizeof(h->date_added));
+}
+
+static void encode_rental(ByteBuf* b, const Rental* rt){
+    buf_u32(b,(uint32_t)rt->id);
+    buf_u32(b,(uint32_t)rt->house_id);
+    buf_u32(b,(uint32_t)rt->tenant_id);
+    buf_u32(b,(uint32_t)rt->landlord_id);
+    buf_str(b,rental_tenant(rt)); buf_str(b,rental_title(rt)); buf_str(b,rt->rental_date);
+    buf_f64(b,rt->monthly_rent);
+    buf_u32(b,rt->is_active);
+}
+
+static void decode_rental(ByteReader* r, Rental* rt){
+    rt->id=(int)rd_u32(r);
+    rt->house_id=(int)rd_u32(r);
+    rt->tenant_id=(int)rd_u32(r);
+    rt->landlord_id=(int)rd_u32(r);
+    RentalNames n;
+    rd_str(r,n.tenant,sizeof(n.tenant)); rd_str(r,n.title,sizeof(n.title));
+    rd_str(r,rt->rental_date,sizeof(rt->rental_date));
+    rt->monthly_rent=rd_f64(r);
+    rt->is_active=rd_u32(r)!=0;
+    if(r->ok) note_departed(rt,&n);
+}
+
+static void encode_snapshot(ByteBuf* b){
+    uint64_t offs[TABLE_COUNT];
+    buf_put(b,"HRSN",4);
+    buf_u32(b,SNAPSHOT_VERSION);
+    buf_u32(b,(uint32_t)user_count);
+    buf_u32(b,(uint32_t)house_count);
+    buf_u32(b,(uint32_t)rental_count);
+    for(int t=0;t<TABLE_COUNT;t++) buf_u64(b,0);   // patched below
+    for(int t=0;t<TABLE_COUNT;t++) buf_u32(b,(uint32_t)id_seq[t]);
+    offs[TABLE_USERS]=b->len;
+    for(int i=0;i<user_count;i++) encode_user(b,&users[i]);
+    offs[TABLE_HOUSES]=b->len;
+    for(int i=0;i<house_count;i++) encode_house(b,&houses[i]);
+    offs[TABLE_RENTALS]=b->len;
+    for(int i=0;i<rental_count;i++) encode_rental(b,&rentals[i]);
+    for(int t=0;t<TABLE_COUNT;t++)
+        for(int k=0;k<8;k++) b->data[20+t*8+k]=(char)(offs[t]>>(8*k));
+}
+
+static bool write_snapshot(const ByteBuf* b){
+    FILE* fp=fopen(SNAPSHOT_FILE ".tmp","wb");
+    if(!fp) return false;
+    bool ok = fwrite(b->data,1,b->len,fp)==b->len && fsync_file(fp);
+    if(fclose(fp)!=0) ok=false;
+    return ok && replace_file(SNAPSHOT_FILE ".tmp",SNAPSHOT_FILE);
+}
+
+typedef struct { TableId table; ByteReader r; uint32_t count; } SnapshotTable;
+
+static THREAD_FUNC decode_snapshot_table(void* arg){
+    SnapshotTable* st=(SnapshotTable*)arg;
+    for(uint32_t i=0;i<st->count && st->r.ok;i++){
+        if(st->table==TABLE_USERS){
+            decode_user(&st->r,&users[i]);
+            user_arena.live+=user_text_bytes(&users[i]);
+        }
+        else if(st->table==TABLE_HOUSES){
+            House h;
+            decode_house(&st->r,&h);
+            house_store((int)i,&h);
+        }
+        else decode_rental(&st->r,&rentals[i]);
+    }
+    return 0;
+}
+
+// Load all three tables from rental.hrs. On any mismatch (missing file, other
+// version, truncation) the tables are left empty and false is returned.
+static bool load_snapshot(void){
+    MappedFile mf;
+    if(!map_file(SNAPSHOT_FILE,&mf)) return false;
+    ByteReader r={(const unsigned char*)mf.data,(const unsigned char*)mf.data+mf.size,true};
+    bool ok = mf.size>=SNAPSHOT_HEADER_SIZE && memcmp(mf.data,"HRSN",4)==0;
+    r.p+=4;
+    uint32_t counts[TABLE_COUNT];
+    uint64_t offs[TABLE_COUNT];
+    uint32_t version=rd_u32(&r);
+    ok = ok && (version==SNAPSHOT_VERSION || version==1);
+    size_t header = (version==1)?SNAPSHOT_V1_HEADER_SIZE:SNAPSHOT_HEADER_SIZE;
+    for(int t=0;t<TABLE_COUNT;t++) counts[t]=rd_u32(&r);
+    for(int t=0;t<TABLE_COUNT;t++) offs[t]=rd_u64(&r);
+    ok = ok && r.ok;
+    // Every record takes at least one byte, which bounds a corrupt count.
+    for(int t=0;t<TABLE_COUNT && ok;t++)
+        ok = offs[t]>=header && offs[t]<=mf.size && counts[t]<=mf.size && counts[t]<=INT_MAX;
+    if(ok){
+        reserve_users((int)counts[TABLE_USERS]);
+        reserve_houses((int)counts[TABLE_HOUSES]);
+        reserve_rentals((int)counts[TABLE_RENTALS]);
+        // Each table region decodes on its own thread.
+        SnapshotTable st[TABLE_COUNT];
+        Thread th[TABLE_COUNT];
+        bool started[TABLE_COUNT];
+        for(int t=0;t<TABLE_COUNT;t++){
+            st[t].table=(TableId)t;
+            st[t].r=r;
+            st[t].r.p=(const unsigned char*)mf.data+offs[t];
+            st[t].count=counts[t];
+            started[t]=thread_start(&th[t],decode_snapshot_table,&st[t]);
+            if(!started[t]) decode_snapshot_table(&st[t]);
+        }
+        for(int t=0;t<TABLE_COUNT;t++){
+            if(started[t]) thread_join(th[t]);
+            ok = ok && st[t].r.ok;
+        }
+    }
+    unmap_file(&mf);
+    if(!ok){
+        user_arena.len=user_arena.live=0;
+        house_arena.len=house_arena.live=0;
+        return false;
+    }
+    user_count=(int)counts[TABLE_USERS];
+    house_count=(int)counts[TABLE_HOUSES];
+    rental_count=(int)counts[TABLE_RENTALS];
+    return true;
+}
+
+static THREAD_FUNC load_users_thread(void* arg){ (void)arg; load_users(); return 0; }
+static THREAD_FUNC load_rentals_thread(void* arg){ (void)arg; load_rentals(); return 0; }
+
+// The three text tables are independent; users and rentals load on their own
+// threads while this one loads (and fans out) houses.
+static void load_text_tables(void){
+    Thread tu, tr;
+    bool su=thread_start(&tu,load_users_thread,NULL);
+    bool sr=thread_start(&tr,load_rentals_thread,NULL);
+    if(!su) load_users();
+    if(!sr) load_rentals();
+    load_houses();
+    if(su) thread_join(tu);
+    if(sr) thread_join(tr);
+}
+
+// Restore the id sequences from the rental.hrs header. This runs even when
+// the text tables were loaded instead, so ids of records deleted before the
+// last snapshot stay retired. The loaded ids raise the sequences as well.
+static void restore_id_sequences(void){
+    unsigned char hdr[SNAPSHOT_HEADER_SIZE];
+    FILE* fp=fopen(SNAPSHOT_FILE,"rb");
+    if(fp){
+        ByteReader r={hdr,hdr+fread(hdr,1,sizeof(hdr),fp),true};
+        fclose(fp);
+        bool ok = r.end-r.p==SNAPSHOT_HEADER_SIZE && memcmp(hdr,"HRSN",4)==0;
+        r.p+=4;
+        ok = ok && rd_u32(&r)==SNAPSHOT_VERSION;
+        r.p+=SNAPSHOT_V1_HEADER_SIZE-8;
+        for(int t=0;t<TABLE_COUNT && ok;t++){
+            int seq=(int)rd_u32(&r);
+            if(r.ok && seq>id_seq[t]) id_seq[t]=seq;
+        }
+    }
+    for(int i=0;i<user_count;i++)   seq_observe(TABLE_USERS,users[i].id);
+    for(int i=0;i<house_count;i++)  seq_observe(TABLE_HOUSES,houses[i].id);
+    for(int i=0;i<rental_count;i++) seq_observe(TABLE_RENTALS,rentals[i].id);
+}
+
+// Modification time of path in the file system's finest unit, or -1 when it
+// is missing. Whole seconds are too coarse: a text edit in the same second as
+// the snapshot must still count as newer.
+static int64_t file_mtime(const char* path){
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA a;
+    if(!GetFileAttributesExA(path,GetFileExInfoStandard,&a)) return -1;
+    return (int64_t)(((uint64_t)a.ftLastWriteTime.dwHighDateTime<<32)|a.ftLastWriteTime.dwLowDateTime);
+#else
+    struct stat st;
+    if(stat(path,&st)!=0) return -1;
+  #if defined(__APPLE__)
+    return (int64_t)st.st_mtimespec.tv_sec*1000000000+st.st_mtimespec.tv_nsec;
+  #else
+    return (int64_t)st.st_mtim.tv_sec*1000000000+st.st_mtim.tv_nsec;
+  #endif
+#endif
+}
+
+// True when rental.hrs exists and no text table was modified after it.
+static bool snapshot_is_newest(void){
+    int64_t snap=file_mtime(SNAPSHOT_FILE);
+    if(snap<0) return false;
+    const char* texts[]={USERS_FILE,HOUSES_FILE,RENTALS_FILE};
+    for(int i=0;i<3;i++)
+        if(file_mtime(texts[i])>snap) return false;
+    return true;
+}
+
+// The journals hold changes since rental.hrs was written. When the text
+// tables are loaded instead of an existing snapshot (a text table is newer,
+// or the snapshot does not load), replaying them would overwrite newer rows,
+// so they are moved aside as *.jnl.old.
+static void set_aside_journals(void){
+    for(int t=0;t<TABLE_COUNT;t++){
+        struct stat st;
+        if(stat(journal_files[t],&st)!=0 || st.st_size==0) continue;
+        char old[64];
+        snprintf(old,sizeof(old),"%s.old",journal_files[t]);
+        if(replace_file(journal_files[t],old))
+            fprintf(stderr,"Note: loaded the text tables, not %s; %s moved to %s\n",
+                    SNAPSHOT_FILE,journal_files[t],old);
+    }
+}
+
+// ---------------- Write-behind -------------
+// Mutations only append to in-memory per-table buffers. A flusher thread
+// waits window_ms after the first change, then writes everything queued in
+// that window with one append + fsync per journal (group commit). A queued
+// snapshot supersedes the journal lines queued before it and is written before
+// any later ones; the superseded lines are kept until the snapshot is on disk,
+// and go to the journals if it cannot be written. With HRS_SYNC_WRITES=1 each
+// change is flushed before the menu returns.
+static struct {
+    Mutex   lock;
+    Cond    wake;
+    ByteBuf lines[TABLE_COUNT];
+    ByteBuf covered[TABLE_COUNT];   // lines the queued snapshot supersedes
+    ByteBuf archive;     // rentals leaving memory; written before the snapshot
+    ByteBuf snapshot;
+    bool    has_snapshot;
+    bool    stop;
+    bool    running;     // flusher thread started
+    bool    archive_mode;
+    unsigned window_ms;
+    Thread  thread;
+} wb;
+
+static bool wb_pending(void){
+    if(wb.has_snapshot) return true;
+    for(int t=0;t<TABLE_COUNT;t++) if(wb.lines[t].len) return true;
+    return false;
+}
+
+// Write out everything queued so far. Only the flusher (or the menu thread in
+// synchronous mode) calls this, so batches never interleave.
+static void wb_write_batch(void){
+    ByteBuf lines[TABLE_COUNT], covered[TABLE_COUNT], snap={0}, archive;
+    bool has_snap;
+    mutex_lock(&wb.lock);
+    for(int t=0;t<TABLE_COUNT;t++){
+        lines[t]=wb.lines[t];
+        covered[t]=wb.covered[t];
+        memset(&wb.lines[t],0,sizeof(ByteBuf));
+        memset(&wb.covered[t],0,sizeof(ByteBuf));
+    }
+    archive=wb.archive;
+    memset(&wb.archive,0,sizeof(ByteBuf));
+    has_snap=wb.has_snapshot;
+    if(has_snap){
+        snap=wb.snapshot;
+        memset(&wb.snapshot,0,sizeof(ByteBuf));
+        wb.has_snapshot=false;
+    }
+    mutex_unlock(&wb.lock);
+
+    // Archived rentals must be on disk before a snapshot that no longer has them.
+    if(archive.len){
+        FILE* fp=fopen(RENTALS_ARCHIVE,"ab");
+        if(!fp || fwrite(archive.data,1,archive.len,fp)!=archive.len || !fsync_file(fp)){
+            fprintf(stderr,"Warning: could not write %s; snapshot skipped\n",RENTALS_ARCHIVE);
+            has_snap=false;
+            mutex_lock(&wb.lock);   // keep the rows queued; memory no longer has them
+            buf_put(&wb.archive,archive.data,archive.len);
+            mutex_unlock(&wb.lock);
+        }
+        if(fp) fclose(fp);
+        free(archive.data);
+    }
+
+    // Replay is idempotent, so a crash between the snapshot and the journal
+    // truncation only replays entries already in the snapshot.
+    bool saved=false;
+    if(has_snap && !(saved=write_snapshot(&snap)))
+        fprintf(stderr,"Warning: could not write %s; keeping the journals\n",SNAPSHOT_FILE);
+    free(snap.data);
+    for(int t=0;t<TABLE_COUNT;t++){
+        if(saved){
+            FILE* fp=fopen(journal_files[t],"w");
+            if(fp) fclose(fp);
+        } else if(covered[t].len){
+            // No snapshot holds these, so they go to the journal ahead of the
+            // lines queued after them.
+            buf_put(&covered[t],lines[t].data,lines[t].len);
+            free(lines[t].data);
+            lines[t]=covered[t];
+            continue;
+        }
+        free(covered[t].data);
+    }
+
+    for(int t=0;t<TABLE_COUNT;t++){
+        if(!lines[t].len){ free(lines[t].data); continue; }
+        FILE* fp=fopen(journal_files[t],"ab");
+        if(!fp || fwrite(lines[t].data,1,lines[t].len,fp)!=lines[t].len || !fsync_file(fp))
+            fprintf(stderr,"Warning: could not write %s\n",journal_files[t]);
+        if(fp) fclose(fp);
+        free(lines[t].data);
+    }
+}
+
+static THREAD_FUNC wb_flusher(void* arg){
+    (void)arg;
+    mutex_lock(&wb.lock);
+    for(;;){
+        while(!wb.stop && !wb_pending()) cond_wait(&wb.wake,&wb.lock);
+        // Coalesce window: later changes and spurious wakeups must not end it
+        // early, only stop does.
+        double deadline=now_seconds()+wb.window_ms/1000.0;
+        while(!wb.stop){
+            double left=deadline-now_seconds();
+            if(left<=0) break;
+            cond_wait_ms(&wb.wake,&wb.lock,(unsigned)(left*1000.0)+1);
+        }
+        bool stop=wb.stop;
+        mutex_unlock(&wb.lock);
+        wb_write_batch();
+        mutex_lock(&wb.lock);
+        if(stop && !wb_pending()) break;
+    }
+    mutex_unlock(&wb.lock);
+    return 0;
+}
+
+static void persist_start(void){
+    mutex_init(&wb.lock);
+    cond_init(&wb.wake);
+    const char* arch=getenv("HRS_ARCHIVE_RENTALS");
+    wb.archive_mode = arch && *arch && strcmp(arch,"0")!=0;
+    const char* win=getenv("HRS_WRITE_BEHIND_MS");
+    char* end;
+    long ms = win?strtol(win,&end,10):-1;
+    wb.window_ms = (win && *win && !*end && ms>=0 && ms<=60000)?(unsigned)ms:WRITE_BEHIND_MS;
+    const char* sync=getenv("HRS_SYNC_WRITES");
+    if(sync && *sync && strcmp(sync,"0")!=0) return;
+    wb.running=thread_start(&wb.thread,wb_flusher,NULL);
+}
+
+// Drain the queue and stop the flusher; called on exit.
+static void persist_stop(void){
+    if(!wb.running){ wb_write_batch(); return; }
+    mutex_lock(&wb.lock);
+    wb.stop=true;
+    cond_signal(&wb.wake);
+    mutex_unlock(&wb.lock);
+    thread_join(wb.thread);
+    wb.running=false;
+}
+
+// Archive mode: move ended rentals out of memory into the archive queue. The
+// highest rental id always stays in memory, so a restart from the text tables
+// without rental.hrs still cannot reuse an archived id.
+static void archive_ended_rentals(void){
+    if(!wb.archive_mode) return;
+    ByteBuf out={0};
+    int max_id=0;
+    for(int i=0;i<rental_count;i++)
+        if(rentals[i].id>max_id) max_id=rentals[i].id;
+    int kept=0;
+    char line[RECORD_LINE_MAX];
+    for(int i=0;i<rental_count;i++){
+        if(!rentals[i].is_active && rentals[i].id!=max_id){
+            int n=format_rental(line,sizeof(line),&rentals[i]);
+            if(n>0) buf_put(&out,line,(size_t)n);
+        } else {
+            rentals[kept++]=rentals[i];
+        }
+    }
+    rental_count=kept;
+    if(!out.len) return;
+    reindex_rentals();
+    prune_all_departed();
+    mutex_lock(&wb.lock);
+    buf_put(&wb.archive,out.data,out.len);
+    mutex_unlock(&wb.lock);
+    free(out.data);
+}
+
+// Queue a snapshot of the current tables; the journal lines queued so far are
+// covered by it and set aside until it is written.
+static void checkpoint(void){
+    ByteBuf b={0};
+    archive_ended_rentals();
+    encode_snapshot(&b);
+    mutex_lock(&wb.lock);
+    free(wb.snapshot.data);
+    wb.snapshot=b;
+    wb.has_snapshot=true;
+    for(int t=0;t<TABLE_COUNT;t++){
+        buf_put(&wb.covered[t],wb.lines[t].data,wb.lines[t].len);
+        wb.lines[t].len=0;
+        journal_pending[t]=0;
+    }
+    cond_signal(&wb.wake);
+    mutex_unlock(&wb.lock);
+    if(!wb.running) wb_write_batch();
+}
+
+// Refresh the text tables for import/export, then snapshot after them so the
+// snapshot stays the newest file. The queue is drained first: rentals.txt is
+// only rewritten without the archived rows once they are in the archive.
+static void save_all(void){
+    archive_ended_rentals();
+    persist_stop();
+    save_users();
+    save_houses();
+    if(wb.archive.len){
+        fprintf(stderr,"Warning: archived rentals not written; keeping %s and the snapshot\n",RENTALS_FILE);
+        return;
+    }
+    save_rentals();
+    checkpoint();   // flusher stopped: written before returning
+}
+
+static void journal_append(TableId t, const char* line, int n){
+    if(n<=0) return;
+    if(n>=RECORD_LINE_MAX) n=RECORD_LINE_MAX-1;
+    mutex_lock(&wb.lock);
+    buf_put(&wb.lines[t],line,(size_t)n);
+    bool full = ++journal_pending[t]>=JOURNAL_COMPACT_AT;
+    cond_signal(&wb.wake);
+    mutex_unlock(&wb.lock);
+    if(full) checkpoint();
+    else if(!wb.running) wb_write_batch();
+}
+
+static void journal_user(char op, const User* u){
+    char line[RECORD_LINE_MAX];
+    int n=snprintf(line,sizeof(line),"%c|",op);
+    n+=format_user(line+n,sizeof(line)-(size_t)n,u);
+    journal_append(TABLE_USERS,line,n);
+}
+
+static void journal_house(char op, const HouseRow* h){
+    char line[RECORD_LINE_MAX];
+    int n=snprintf(line,sizeof(line),"%c|",op);
+    n+=format_house(line+n,sizeof(line)-(size_t)n,h);
+    journal_append(TABLE_HOUSES,line,n);
+}
+
+static void journal_rental(char op, const Rental* r){
+    char line[RECORD_LINE_MAX];
+    int n=snprintf(line,sizeof(line),"%c|",op);
+    n+=format_rental(line+n,sizeof(line)-(size_t)n,r);
+    journal_append(TABLE_RENTALS,line,n);
+}
+
+static void journal_delete(TableId t, int id){
+    char line[32];
+    journal_append(t,line,snprintf(line,sizeof(line),"D|%d\n",id));
+}
+
+// Apply the journal on top of the loaded snapshot. Lines that do not parse
+// (e.g. a torn final append) are skipped.
+static void replay_journal(TableId t){
+    FILE* fp=fopen(journal_files[t],"r");
+    if(!fp) return;
+    char line[2048];
+    while(fgets(line,sizeof(line),fp)){
+        char op=line[0];
+        if(line[1]!='|' || (op!='I' && op!='U' && op!='D')) continue;
+        journal_pending[t]++;
+        const char* rec=line+2;
+        LineScan ls;
+        scan_line(rec,rec+strlen(rec),&ls);
+        if(op=='D'){
+            int id=atoi(rec);
+            if(t==TABLE_USERS){
+                User* u=find_user_by_id(id);
+                if(u) remove_user_at((int)(u-users));
+            } else if(t==TABLE_HOUSES){
+                HouseRow* h=find_house_by_id(id);
+                if(h) remove_house_at((int)(h-houses));
+            } else {
+                Rental* r=find_rental_by_id(id);
+                if(r) remove_rental_at((int)(r-rentals));
+            }
+        } else if(t==TABLE_USERS){
+            User u;
+            if(parse_user(&ls,&u)) upsert_user(&u);
+        } else if(t==TABLE_HOUSES){
+            House h;
+            if(parse_house(&ls,&h)) upsert_house(&h);
+        } else {
+            Rental r;
+            RentalNames n;
+            if(parse_rental(&ls,&r,&n)){
+                note_departed(&r,&n);
+                upsert_rental(&r);
+            }
+        }
+    }
+    fclose(fp);
+}
+
+// Base tables (snapshot or text), then the journals, then the flusher.
+static void load_all(void){
+    if(!(snapshot_is_newest() && load_snapshot())){
+        load_text_tables();
+        if(file_mtime(SNAPSHOT_FILE)>=0) set_aside_journals();
+    }
+    restore_id_sequences();
+    reindex_users();
+    reindex_usernames();
+    reindex_houses();
+    reindex_facets();
+    reindex_rentals();
+    for(int t=0;t<TABLE_COUNT;t++) replay_journal((TableId)t);
+    prune_all_departed();
+    persist_start();
+    for(int t=0;t<TABLE_COUNT;t++)
+        if(journal_pending[t]>=JOURNAL_COMPACT_AT){ checkpoint(); break; }
+}
+
+// ---------------- Rental cursor ------------
+// Streams rentals from a table file (normally the archive) in bounded memory.
+// The id/active filters are checked on the leading integer fields before the
+// string fields are copied, so non-matching rows cost only a scan.
+#define CURSOR_BUF_SIZE (64*1024)
+
+typedef struct {
+    int tenant_id, landlord_id, house_id;   // 0 = any
+    int active;                             // -1 any, 0 ended, 1 active
+    char date_from[20], date_to[20];        // inclusive YYYY-MM-DD, "" = open
+} RentalFilter;
+
+typedef struct {
+    FILE* fp;
+    RentalFilter filter;
+    char   buf[CURSOR_BUF_SIZE];
+    size_t len, pos;
+    bool   eof;
+} RentalCursor;
+
+static bool rental_matches_ids(const RentalFilter* f, int house_id, int tenant_id, int landlord_id){
+    return (!f->house_id || f->house_id==house_id) && (!f->tenant_id || f->tenant_id==tenant_id) &&
+           (!f->landlord_id || f->landlord_id==landlord_id);
+}
+
+static bool rental_matches(const RentalFilter* f, const Rental* r){
+    return rental_matches_ids(f,r->house_id,r->tenant_id,r->landlord_id) &&
+           (f->active<0 || (bool)f->active==r->is_active) &&
+           (!f->date_from[0] || strcmp(r->rental_date,f->date_from)>=0) &&
+           (!f->date_to[0] || strcmp(r->rental_date,f->date_to)<=0);
+}
+
+static bool rental_cursor_open(RentalCursor* c, const char* path, const RentalFilter* f){
+    c->fp=fopen(path,"rb");
+    c->filter=*f;
+    c->len=c->pos=0;
+    c->eof=false;
+    return c->fp!=NULL;
+}
+
+static void rental_cursor_close(RentalCursor* c){
+    if(c->fp) fclose(c->fp);
+    c->fp=NULL;
+}
+
+// Next matching rental, or false at the end of the file. names gets the
+// row's tenant and title, joined to the live tables where the ids still exist.
+static bool rental_cursor_next(RentalCursor* c, Rental* out, RentalNames* names){
+    for(;;){
+        const char* start=c->buf+c->pos;
+        const char* nl=memchr(start,'\n',c->len-c->pos);
+        if(!nl && !c->eof){
+            // Refill: keep the partial line, or drop it if it fills the buffer.
+            if(c->pos==0 && c->len==sizeof(c->buf)) c->len=0;
+            memmove(c->buf,start,c->len-c->pos);
+            c->len-=c->pos;
+            c->pos=0;
+            size_t got=fread(c->buf+c->len,1,sizeof(c->buf)-c->len,c->fp);
+            c->len+=got;
+            if(got==0) c->eof=true;
+            continue;
+        }
+        if(!nl && c->pos==c->len) return false;
+        const char* end=nl?nl:c->buf+c->len;
+        c->pos=(size_t)(end-c->buf)+(nl?1:0);
+
+        LineScan ls;
+        scan_line(start,end,&ls);
+        Fields f={ls.start,&ls,0};
+        int id, house_id, tenant_id, landlord_id;
+        if(!(field_int(&f,&id,false) && field_int(&f,&house_id,false) &&
+             field_int(&f,&tenant_id,false) && field_int(&f,&landlord_id,false)))
+            continue;
+        if(!rental_matches_ids(&c->filter,house_id,tenant_id,landlord_id)) continue;
+        if(parse_rental(&ls,out,names) && rental_matches(&c->filter,out)){
+            join_rental_names(out,names);
+            return true;
+        }
+    }
+}
+
+// --------------- Auth ----------------------
+// The user these credentials belong to, active or not.
+static User* find_login(const char* uname, const char* pw){
+    User* u=find_user_by_username(uname);
+    return (u && strcmp(user_str(u->password),pw)==0)?u:NULL;
+}
+
+static User* authenticate(void){
+    char uname[64], pw[64];
+    input_line("Username: ", uname, sizeof(uname));
+    input_line("Password: ", pw, sizeof(pw));
+    User* u=find_login(uname,pw);
+    if(u){
+        if(!u->is_active){
+            printf(RED "Account inactive.\n" RESET);
+            return NULL;
+        }
+        return u;
+    }
+    printf(RED "Invalid credentials.\n" RESET);
+    return NULL;
+}
+
+static void register_user(void){
+    User u;
+    memset(&u,0,sizeof(u));
+    char username[USERNAME_MAX], password[PASSWORD_MAX], full_name[FULL_NAME_MAX];
+    char email[EMAIL_MAX], phone[PHONE_MAX];
+    u.id = next_user_id();
+    input_line("Username: ", username, sizeof(username));
+
+    // uniqueness check
+    if(find_user_by_username(username)){
+        printf(RED "Username already exists.\n" RESET);
+        return;
+    }
+
+    input_line("Password: ", password, sizeof(password));
+    input_line("Full name: ", full_name, sizeof(full_name));
+    input_line("Email: ", email, sizeof(email));
+    input_line("Phone: ", phone, sizeof(phone));
+    user_set_text(&u,username,password,full_name,email,phone);
+    printf("Role: 0=Admin, 1=Landlord, 2=Tenant\n");
+    u.role = (UserRole)read_int_range("Select role: ",0,2,2,false);
+    u.is_active = true;
+    add_user(&u);
+    journal_user('I',&u);
+    printf(GREEN "Registered user with ID %d\n" RESET, u.id);
+}
+
+// ---------------- Paging ------------------
+// Listings are paged in id order behind a cursor that is just the last id
+// shown, so rows added or removed between pages never repeat or skip the
+// rest. While a table's slots are still id-ordered the page starts at a
+// binary search and costs O(log n + page); otherwise the next page is picked
+// from one pass with a bounded heap of page size.
+typedef struct {
+    const char* ids;        // &table[0].id
+    size_t stride;          // sizeof one record
+    int    count;
+    bool   ascending;
+    const Bitmap* only;     // slots to list; NULL = all
+} PagedTable;
+
+#define SLOT_ID(t,i) (*(const int*)((t)->ids+(size_t)(i)*(t)->stride))
+
+// Max-heap on id, so the root is the largest id kept so far.
+static void slot_heap_sift(const PagedTable* t, int* h, int n, int i){
+    for(;;){
+        int l=2*i+1, m=i;
+        if(l<n && SLOT_ID(t,h[l])>SLOT_ID(t,h[m])) m=l;
+        if(l+1<n && SLOT_ID(t,h[l+1])>SLOT_ID(t,h[m])) m=l+1;
+        if(m==i) return;
+        int x=h[i]; h[i]=h[m]; h[m]=x;
+        i=m;
+    }
+}
+
+// Fill slots[] with up to k listed slots whose ids follow after_id, in id
+// order; returns how many.
+static int page_slots(const PagedTable* t, int after_id, int* slots, int k){
+    if(k<=0) return 0;
+    int n=0;
+    if(t->ascending){
+        int lo=0, hi=t->count;
+        while(lo<hi){
+            int mid=(lo+hi)/2;
+            if(SLOT_ID(t,mid)<=after_id) lo=mid+1; else hi=mid;
+        }
+        if(!t->only){
+            for(int i=lo;i<t->count && n<k;i++) slots[n++]=i;
+        }
+        else{
+            for(int i=bitmap_next(t->only,lo,t->count); i>=0 && n<k; i=bitmap_next(t->only,i+1,t->count))
+                slots[n++]=i;
+        }
+        return n;
+    }
+    for(int i=0;i<t->count;i++){
+        if(t->only && bitmap_next(t->only,i,i+1)<0) continue;
+        int id=SLOT_ID(t,i);
+        if(id<=after_id) continue;
+        if(n<k){
+            slots[n]=i;
+            for(int c=n++; c>0 && SLOT_ID(t,slots[(c-1)/2])<id; c=(c-1)/2){
+                int x=slots[c]; slots[c]=slots[(c-1)/2]; slots[(c-1)/2]=x;
+            }
+        }
+        else if(id<SLOT_ID(t,slots[0])){
+            slots[0]=i;
+            slot_heap_sift(t,slots,n,0);
+        }
+    }
+    // Heap-sort in place: pop the largest to the back.
+    for(int m=n-1;m>0;m--){
+        int x=slots[0]; slots[0]=slots[m]; slots[m]=x;
+        slot_heap_sift(t,slots,m,0);
+    }
+    return n;
+}
+
+typedef void (*SlotPrinter)(int slot);
+
+// Print a table a page at a time until it runs out or the user stops.
+static void page_through(const PagedTable* t, SlotPrinter header, SlotPrinter row){
+    int slots[BROWSE_PAGE_SIZE+1];
+    int after=INT_MIN;
+    for(int page=1;;page++){
+        // One extra slot tells whether another page follows.
+        int n=page_slots(t,after,slots,BROWSE_PAGE_SIZE+1);
+        if(!n){
+            printf("No rows.\n");
+            return;
+        }
+        int shown=n>BROWSE_PAGE_SIZE?BROWSE_PAGE_SIZE:n;
+        printf(CYAN "-- page %d --\n" RESET,page);
+        header(-1);
+        for(int i=0;i<shown;i++) row(slots[i]);
+        if(n<=BROWSE_PAGE_SIZE){
+            printf("End of results.\n");
+            return;
+        }
+        after=SLOT_ID(t,slots[shown-1]);
+        char line[8];
+        input_line("Enter for next page, q to stop: ",line,sizeof(line));
+        if(line[0]=='q' || line[0]=='Q') return;
+    }
+}
+
+// Top-K selection: keeps the k best (key, id) pairs seen, in a bounded heap
+// whose root is the worst kept, so n offers cost O(n log k) and no sort of
+// the whole candidate set is needed.
+typedef struct { double key; int id; } TopItem;
+typedef struct {
+    TopItem* items;
+    int len, k;
+    bool desc;              // largest keys are best
+} TopK;
+
+// a ranks after b: larger key first when ascending, ties to the larger id.
+static bool top_worse(const TopK* t, const TopItem* a, const TopItem* b){
+    if(a->key!=b->key) return t->desc ? a->key<b->key : a->key>b->key;
+    return a->id>b->id;
+}
+
+static void top_sift(TopK* t, int i, int n){
+    for(;;){
+        int l=2*i+1, m=i;
+        if(l<n && top_worse(t,&t->items[l],&t->items[m])) m=l;
+        if(l+1<n && top_worse(t,&t->items[l+1],&t->items[m])) m=l+1;
+        if(m==i) return;
+        TopItem x=t->items[i]; t->items[i]=t->items[m]; t->items[m]=x;
+        i=m;
+    }
+}
+
+static void top_offer(TopK* t, double key, int id){
+    TopItem it={key,id};
+    if(t->len<t->k){
+        int c=t->len++;
+        for(; c>0 && top_worse(t,&it,&t->items[(c-1)/2]); c=(c-1)/2)
+            t->items[c]=t->items[(c-1)/2];
+        t->items[c]=it;
+    }
+    else if(t->k>0 && top_worse(t,&t->items[0],&it)){
+        t->items[0]=it;
+        top_sift(t,0,t->len);
+    }
+}
+
+// Order the kept items best first; the heap is consumed.
+static void top_finish(TopK* t){
+    for(int m=t->len-1;m>0;m--){
+        TopItem x=t->items[0]; t->items[0]=t->items[m]; t->items[m]=x;
+        top_sift(t,0,m);
+    }
+}
+
+// --------------- Admin Features ------------
+static void print_user_header(int slot){
+    (void)slot;
+    printf("%-4s | %-14s | %-22s | %-9s | %-6s\n","ID","Username","Full Name","Role","Active");
+}
+
+static void print_user_row(int i){
+    printf("%-4d | %-14s | %-22s | %-9s | %-6s\n",
+           users[i].id, user_str(users[i].username), user_str(users[i].full_name),
+           role_str(users[i].role), users[i].is_active?"Yes":"No");
+}
+
+static void admin_list_users(void){
+    printf(CYAN "\n-- Users (%d) --\n" RESET,user_count);
+    PagedTable t={(const char*)&users[0].id,sizeof(User),user_count,ids_ascending[TABLE_USERS],NULL};
+    page_through(&t,print_user_header,print_user_row);
+}
+
+static void admin_toggle_active(void){
+    int id = read_int_range("User ID to toggle active: ",1,2147483647,0,false);
+    User* u = find_user_by_id(id);
+    if(!u){
+        printf(RED "User not found.\n" RESET);
+        return;
+    }
+    u->is_active = !u->is_active;
+    journal_user('U',u);
+    printf(GREEN "User %d active=%s\n" RESET, id, u->is_active?"true":"false");
+}
+
+static void admin_reset_password(void){
+    int id = read_int_range("User ID to reset password: ",1,2147483647,0,false);
+    User* u = find_user_by_id(id);
+    if(!u){
+        printf(RED "User not found.\n" RESET);
+        return;
+    }
+    user_set_field(&u->password,"1234");
+    journal_user('U',u);
+    printf(GREEN "Password reset to '1234' for user %d\n" RESET, id);
+}
+
+static void print_house_header(int slot){
+    (void)slot;
+    printf("%-4s | %-18s | %-10s | %-10s | %3s | %3s | %-12s | %-9s\n",
+           "ID","Title","City","Area","Bd","Bt","Status","Rent");
+}
+
+static void print_house_row(int i){
+    printf("%-4d | %-18s | %-10s | %-10s | %3d | %3d | %-12s | %9.2f\n",
+           houses[i].id, house_str(house_text[i].title), sym_str(house_text[i].city_sym),
+           sym_str(house_text[i].area_sym),
+           houses[i].bedrooms, houses[i].bathrooms, status_str(houses[i].status),
+           houses[i].rent);
+}
+
+static void admin_list_houses(void){
+    printf(CYAN "\n-- Houses (%d) --\n" RESET,house_count);
+    PagedTable t={(const char*)&houses[0].id,sizeof(HouseRow),house_count,ids_ascending[TABLE_HOUSES],NULL};
+    page_through(&t,print_house_header,print_house_row);
+}
+
+static void print_rental_header(int slot){
+    (void)slot;
+    printf("%-4s | %-18s | %-18s | %-10s | %-6s | %-9s\n",
+           "ID","Tenant","House","StartDate","Active","Rent");
+}
+
+static void print_rental_row(int i){
+    printf("%-4d | %-18s | %-18s | %-10s | %-6s | %9.2f\n",
+           rentals[i].id, rental_tenant(&rentals[i]), rental_title(&rentals[i]),
+           rentals[i].rental_date, rentals[i].is_active?"Yes":"No",
+           rentals[i].monthly_rent);
+}
+
+static void admin_list_rentals(void){
+    printf(CYAN "\n-- Rentals (%d) --\n" RESET,rental_count);
+    PagedTable t={(const char*)&rentals[0].id,sizeof(Rental),rental_count,ids_ascending[TABLE_RENTALS],NULL};
+    page_through(&t,print_rental_header,print_rental_row);
+}
+
+static int read_filter_id(const char* prompt){
+    return read_int_range(prompt,0,2147483647,0,true);
+}
+
+// Rentals in memory plus the on-disk archive, streamed through the cursor.
+static void admin_rental_report(void){
+    RentalFilter f;
+    memset(&f,0,sizeof(f));
+    printf(YELLOW "Leave blank for any.\n" RESET);
+    f.tenant_id   = read_filter_id("Tenant ID: ");
+    f.landlord_id = read_filter_id("Landlord ID: ");
+    f.house_id    = read_filter_id("House ID: ");
+    printf("Active: 0=Ended, 1=Active\n");
+    f.active      = read_int_range("Active (blank any): ",0,1,-1,true);
+    input_line("From date (YYYY-MM-DD): ", f.date_from, sizeof(f.date_from));
+    input_line("To date (YYYY-MM-DD): ", f.date_to, sizeof(f.date_to));
+
+    printf(CYAN "\n-- Rental Report --\n" RESET);
+    printf("%-4s | %-18s | %-18s | %-10s | %-6s | %-9s\n",
+           "ID","Tenant","House","StartDate","Active","Rent");
+    long count=0;
+    double total=0;
+    for(int i=0;i<rental_count;i++){
+        const Rental* r=&rentals[i];
+        if(!rental_matches(&f,r)) continue;
+        printf("%-4d | %-18s | %-18s | %-10s | %-6s | %9.2f\n",
+               r->id, rental_tenant(r), rental_title(r), r->rental_date,
+               r->is_active?"Yes":"No", r->monthly_rent);
+        count++;
+        total+=r->monthly_rent;
+    }
+    RentalCursor* c=malloc(sizeof(RentalCursor));
+    if(c && rental_cursor_open(c,RENTALS_ARCHIVE,&f)){
+        Rental r;
+        RentalNames n;
+        while(rental_cursor_next(c,&r,&n)){
+            printf("%-4d | %-18s | %-18s | %-10s | %-6s | %9.2f\n",
+                   r.id, n.tenant, n.title, r.rental_date,
+                   r.is_active?"Yes":"No", r.monthly_rent);
+            count++;
+            total+=r.monthly_rent;
+        }
+        rental_cursor_close(c);
+    }
+    free(c);
+    printf("%ld rental(s), total monthly rent %.2f\n", count, total);
+}
+
+static double kib(size_t n){ return (double)n/1024.0; }
+
+static void print_memory_row(const char* table, int rows, size_t row_bytes,
+                             const Arena* a, size_t fixed_bytes){
+    size_t text=a?a->cap:0, junk=a?a->len-a->live:0;
+    printf("%-8s | %9d | %11.1f | %11.1f | %11.1f | %11.1f | %11.1f\n",
+           table, rows, kib(row_bytes), kib(text), kib(junk), kib(row_bytes+text), kib(fixed_bytes));
+}
+
+// Resident bytes per table next to what the same rows cost with the text
+// held in fixed-width char arrays sized for the longest accepted value.
+static void admin_memory_report(void){
+    const size_t user_fixed = sizeof(User)-5*sizeof(Str)+
+        USERNAME_MAX+PASSWORD_MAX+FULL_NAME_MAX+EMAIL_MAX+PHONE_MAX;
+    const size_t house_fixed = sizeof(HouseRow)+sizeof(HouseText)-3*sizeof(Str)+
+        sizeof(((House*)0)->title)+sizeof(((House*)0)->address)+sizeof(((House*)0)->description);
+    size_t user_rows=(size_t)user_count*sizeof(User);
+    size_t house_rows=(size_t)house_count*(sizeof(HouseRow)+sizeof(HouseText));
+    size_t rental_rows=(size_t)rental_count*sizeof(Rental);
+
+    printf(CYAN "\n-- Memory Report --\n" RESET);
+    printf("%-8s | %9s | %11s | %11s | %11s | %11s | %11s\n",
+           "Table","Rows","Rows KiB","Text KiB","Garbage KiB","Total KiB","Fixed KiB");
+    print_memory_row("users",user_count,user_rows,&user_arena,(size_t)user_count*user_fixed);
+    print_memory_row("houses",house_count,house_rows,&house_arena,(size_t)house_count*house_fixed);
+    print_memory_row("rentals",rental_count,rental_rows,NULL,rental_rows);
+    size_t total=user_rows+user_arena.cap+house_rows+house_arena.cap+rental_rows;
+    size_t fixed=(size_t)user_count*user_fixed+(size_t)house_count*house_fixed+rental_rows;
+    printf("Total %.1f KiB, %.1f%% of the fixed-width layout (%.1f KiB)\n",
+           kib(total), fixed?100.0*(double)total/(double)fixed:100.0, kib(fixed));
+}
+
+// --------------- Landlord Features ---------
+static void landlord_list_my_houses(const User* owner){
+    printf(CYAN "\n-- My Houses (%s) --\n" RESET, user_str(owner->full_name));
+    printf("%-4s | %-18s | %-10s | %-10s | %3s | %3s | %-12s | %-9s\n",
+           "ID","Title","City","Area","Bd","Bt","Status","Rent");
+    const IdList* mine=multi_get(&landlord_houses,owner->id);
+    for(int i=0; mine && i<mine->len; i++){
+        const HouseRow* h=find_house_by_id(mine->ids[i]);
+        const HouseText* t=text_of(h);
+        printf("%-4d | %-18s | %-10s | %-10s | %3d | %3d | %-12s | %9.2f\n",
+               h->id, house_str(t->title), sym_str(t->city_sym), sym_str(t->area_sym),
+               h->bedrooms, h->bathrooms, status_str(h->status), h->rent);
+    }
+}
+
+static void landlord_view_rentals(const User* owner){
+    printf(CYAN "\n-- My Rentals (%s) --\n" RESET, user_str(owner->full_name));
+    printf("%-4s | %-18s | %-18s | %-10s | %-6s | %-9s\n",
+           "ID","Tenant","House","StartDate","Active","Rent");
+    const IdList* mine=multi_get(&landlord_rentals,owner->id);
+    if(!mine || !mine->len){
+        printf("No rentals found.\n");
+        return;
+    }
+    for(int i=0;i<mine->len;i++){
+        const Rental* r=find_rental_by_id(mine->ids[i]);
+        printf("%-4d | %-18s | %-18s | %-10s | %-6s | %9.2f\n",
+               r->id, rental_tenant(r), rental_title(r), r->rental_date,
+               r->is_active?"Yes":"No", r->monthly_rent);
+    }
+}
+
+static void landlord_add_house(User* owner){
+    House h;
+    memset(&h,0,sizeof(h));
+    h.id = next_house_id();
+    input_line("Title: ", h.title, sizeof(h.title));
+    input_line("Address: ", h.address, sizeof(h.address));
+    input_line("City: ", h.city, sizeof(h.city));
+    input_line("Area: ", h.area, sizeof(h.area));
+    h.bedrooms  = read_int_range("Bedrooms (0-50): ",0,50,0,false);
+    h.bathrooms = read_int_range("Bathrooms (0-50): ",0,50,0,false);
+    h.rent      = round_rent(read_double_nonneg("Monthly Rent: ", 0, false));
+    input_line("Description: ", h.description, sizeof(h.description));
+    h.landlord_id = owner->id;
+    strncpy(h.landlord_name, user_str(owner->full_name), sizeof(h.landlord_name)-1);
+    h.landlord_name[sizeof(h.landlord_name)-1] = '\0';
+    strncpy(h.date_added, today(), sizeof(h.date_added)-1);
+    h.date_added[sizeof(h.date_added)-1] = '\0';
+    h.status = STATUS_AVAILABLE;
+    journal_house('I',add_house(&h));
+    printf(GREEN "House added with ID %d\n" RESET, h.id);
+}
+
+static void landlord_change_status(User* owner){
+    int id = read_int_range("House ID to change status: ",1,2147483647,0,false);
+    HouseRow* h = find_house_by_id(id);
+    if(!h || h->landlord_id!=owner->id){
+        printf(RED "House not found or not yours.\n" RESET);
+        return;
+    }
+    printf("Status: 0=Available, 1=Rented, 2=Maintenance\n");
+    int st = read_int_range("New status: ",0,2,h->status,false);
+    set_house_status(h,(HouseStatus)st);
+    journal_house('U',h);
+    printf(GREEN "Status updated.\n" RESET);
+}
+
+// Prompt for a replacement value of at most n-1 characters; a blank line
+// keeps the current one.
+static void edit_text(const char* prompt, char* field, size_t n){
+    char line[sizeof(((House*)0)->description)];
+    input_line(prompt,line,n<sizeof(line)?n:sizeof(line));
+    if(line[0]) memcpy(field,line,strlen(line)+1);
+}
+
+static void landlord_edit_house(User* owner){
+    int id = read_int_range("House ID to edit: ",1,2147483647,0,false);
+    HouseRow* h = find_house_by_id(id);
+    if(!h || h->landlord_id!=owner->id){
+        printf(RED "House not found or not yours.\n" RESET);
+        return;
+    }
+    House e;      // edited copy; replace_house() moves it in the indexes
+    house_load((int)(h-houses),&e);
+    char prompt[600];
+    printf(YELLOW "Leave blank to keep current.\n" RESET);
+
+    snprintf(prompt,sizeof(prompt),"Title [%s]: ",e.title);
+    edit_text(prompt,e.title,sizeof(e.title));
+    snprintf(prompt,sizeof(prompt),"Address [%s]: ",e.address);
+    edit_text(prompt,e.address,sizeof(e.address));
+    snprintf(prompt,sizeof(prompt),"City [%s]: ",e.city);
+    edit_text(prompt,e.city,sizeof(e.city));
+    snprintf(prompt,sizeof(prompt),"Area [%s]: ",e.area);
+    edit_text(prompt,e.area,sizeof(e.area));
+
+    e.bedrooms  = read_int_range("Bedrooms (blank keep): ",0,50,e.bedrooms,true);
+    e.bathrooms = read_int_range("Bathrooms (blank keep): ",0,50,e.bathrooms,true);
+    e.rent      = round_rent(read_double_nonneg("Monthly Rent (blank keep): ",e.rent,true));
+
+    edit_text("Description [current kept if blank]\n> ",e.description,sizeof(e.description));
+
+    replace_house(h,&e);
+    journal_house('U',h);
+    printf(GREEN "House updated.\n" RESET);
+}
+
+static void landlord_delete_house(User* owner){
+    int id = read_int_range("House ID to delete: ",1,2147483647,0,false);
+    int idx=idx_get(&house_index,id);
+    if(idx<0 || houses[idx].landlord_id!=owner->id){
+        printf(RED "House not found or not yours.\n" RESET);
+        return;
+    }
+
+    // Block delete if active rental exists
+    if(idx_get(&house_active_rental,id)>=0){
+        printf(RED "Active rental exists; cannot delete.\n" RESET);
+        return;
+    }
+
+    remove_house_at(idx);
+    journal_delete(TABLE_HOUSES,id);
+    printf(GREEN "House deleted.\n" RESET);
+}
+
+// --------------- Tenant Features ----------
+static void print_browse_header(void){
+    printf("%-4s | %-18s | %-10s | %-10s | %3s | %3s | %-9s\n",
+           "ID","Title","City","Area","Bd","Bt","Rent");
+}
+
+static void print_browse_row(const HouseRow* h){
+    const HouseText* t=text_of(h);
+    printf("%-4d | %-18s | %-10s | %-10s | %3d | %3d | %9.2f\n",
+           h->id, house_str(t->title), sym_str(t->city_sym), sym_str(t->area_sym),
+           h->bedrooms, h->bathrooms, h->rent);
+}
+
+static void print_browse_header_slot(int slot){ (void)slot; print_browse_header(); }
+static void print_browse_slot(int slot){ print_browse_row(&houses[slot]); }
+
+static void tenant_browse_available(void){
+    const Bitmap* avail=&status_bits[STATUS_AVAILABLE];
+    printf(CYAN "\n-- Available Houses (%d) --\n" RESET,bitmap_count(avail,house_count));
+    PagedTable t={(const char*)&houses[0].id,sizeof(HouseRow),house_count,ids_ascending[TABLE_HOUSES],avail};
+    page_through(&t,print_browse_header_slot,print_browse_slot);
+}
+
+// Next available house in the rent range, starting at n and walking in the
+// browse direction; NULL once the range is exhausted.
+static RentNode* rent_next_available(RentNode* n, bool desc, double lo, double hi){
+    for(; n; n=desc?n->prev:n->next[0]){
+        if(desc ? n->rent<lo : (hi>=0 && n->rent>hi)) return NULL;
+        if(find_house_by_id(n->id)->status==STATUS_AVAILABLE) return n;
+    }
+    return NULL;
+}
+
+// Available houses in a rent range, sorted by rent, one page at a time.
+static void tenant_browse_by_price(void){
+    double lo=read_double_nonneg("Min rent (blank 0): ",0,true);
+    double hi=read_double_nonneg("Max rent (blank any): ",-1,true);
+    printf("Order: 0=Cheapest first, 1=Most expensive first\n");
+    bool desc=read_int_range("Order (blank 0): ",0,1,0,true)==1;
+
+    RentNode* n = desc ? (hi<0 ? rent_index.tail : rent_seek_back(hi,INT_MAX))
+                       : rent_seek(lo,INT_MIN);
+    n=rent_next_available(n,desc,lo,hi);
+    if(!n){
+        printf(YELLOW "No available houses in that range.\n" RESET);
+        return;
+    }
+    for(int page=1;;page++){
+        printf(CYAN "\n-- Available by Rent (page %d) --\n" RESET,page);
+        print_browse_header();
+        for(int shown=0; n && shown<BROWSE_PAGE_SIZE; shown++){
+            print_browse_row(find_house_by_id(n->id));
+            n=rent_next_available(desc?n->prev:n->next[0],desc,lo,hi);
+        }
+        if(!n){
+            printf("End of results.\n");
+            return;
+        }
+        char line[8];
+        input_line("Enter for next page, q to stop: ",line,sizeof(line));
+        if(line[0]=='q' || line[0]=='Q') return;
+    }
+}
+
+// Keyword search over title, description, city and area; every word must
+// match, and the best BM25 matches come first.
+static void tenant_search_listings(void){
+    char query[200];
+    input_line("Search words: ",query,sizeof(query));
+    TextHit hits[BROWSE_PAGE_SIZE];
+    long matched;
+    double t0=now_seconds();
+    int n=text_search(query,true,hits,BROWSE_PAGE_SIZE,&matched);
+    double ms=(now_seconds()-t0)*1e3;
+    if(!n){
+        printf(YELLOW "No available houses match.\n" RESET);
+        return;
+    }
+    printf(CYAN "\n-- Best Matches --\n" RESET);
+    print_browse_header();
+    for(int i=0;i<n;i++) print_browse_row(find_house_by_id(hits[i].id));
+    printf("%ld listings match, best %d available shown (%.2f ms)\n",matched,n,ms);
+}
+
+// ------------- Filter Kernels -------------
+// A conjunctive numeric predicate over the house columns, evaluated 64 slots
+// at a time into a selection word: bit i is set when slot from+i passes.
+// Open bounds are the extreme values, so every condition is always applied
+// and the loops have no branches: 8 rows per step with AVX2, 4 with SSE2,
+// and a scalar loop for the tail and for other targets.
+typedef struct {
+    int32_t status;                        // -1 = any
+    int32_t min_bedrooms, min_bathrooms;   // INT32_MIN = any
+    int64_t rent_lo, rent_hi;              // cents, inclusive
+} NumericFilter;
+
+static uint64_t select_numeric_scalar(const HouseColumns* c, const NumericFilter* f, int from, int n){
+    uint64_t m=0;
+    for(int i=0;i<n;i++){
+        int s=from+i;
+        bool ok = (f->status<0 || c->status[s]==f->status) &&
+                  c->bedrooms[s]>=f->min_bedrooms && c->bathrooms[s]>=f->min_bathrooms &&
+                  c->rent_cents[s]>=f->rent_lo && c->rent_cents[s]<=f->rent_hi;
+        m|=(uint64_t)ok<<i;
+    }
+    return m;
+}
+
+#if !defined(__AVX2__) && (defined(__SSE2__) || defined(_M_X64))
+// Signed 64-bit a > b per lane; SSE2 only compares 32-bit lanes, so the high
+// halves compare signed and break ties on the low halves compared unsigned.
+static __m128i cmpgt_epi64_sse2(__m128i a, __m128i b){
+    const __m128i bias=_mm_set_epi32(0,INT_MIN,0,INT_MIN);
+    __m128i gt=_mm_cmpgt_epi32(a,b);
+    __m128i eq=_mm_cmpeq_epi32(a,b);
+    __m128i lo_gt=_mm_cmpgt_epi32(_mm_xor_si128(a,bias),_mm_xor_si128(b,bias));
+    __m128i hi_gt=_mm_shuffle_epi32(gt,_MM_SHUFFLE(3,3,1,1));
+    __m128i hi_eq=_mm_shuffle_epi32(eq,_MM_SHUFFLE(3,3,1,1));
+    return _mm_or_si128(hi_gt,_mm_and_si128(hi_eq,_mm_shuffle_epi32(lo_gt,_MM_SHUFFLE(2,2,0,0))));
+}
+#endif
+
+// n <= 64 slots starting at from.
+static uint64_t select_numeric(const HouseColumns* c, const NumericFilter* f, int from, int n){
+    uint64_t m=0;
+    int i=0;
+#if defined(__AVX2__)
+    const __m256i want=_mm256_set1_epi32(f->status);
+    const __m256i any=_mm256_set1_epi32(f->status<0?-1:0);
+    const __m256i beds=_mm256_set1_epi32(f->min_bedrooms), baths=_mm256_set1_epi32(f->min_bathrooms);
+    const __m256i lo=_mm256_set1_epi64x(f->rent_lo), hi=_mm256_set1_epi64x(f->rent_hi);
+    for(; i+8<=n; i+=8){
+        int s=from+i;
+        __m256i st=_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(c->status+s)));
+        __m256i ok=_mm256_or_si256(_mm256_cmpeq_epi32(st,want),any);
+        __m256i v=_mm256_loadu_si256((const __m256i*)(c->bedrooms+s));
+        ok=_mm256_andnot_si256(_mm256_cmpgt_epi32(beds,v),ok);
+        v=_mm256_loadu_si256((const __m256i*)(c->bathrooms+s));
+        ok=_mm256_andnot_si256(_mm256_cmpgt_epi32(baths,v),ok);
+        __m256i r0=_mm256_loadu_si256((const __m256i*)(c->rent_cents+s));
+        __m256i r1=_mm256_loadu_si256((const __m256i*)(c->rent_cents+s+4));
+        __m256i out0=_mm256_or_si256(_mm256_cmpgt_epi64(lo,r0),_mm256_cmpgt_epi64(r0,hi));
+        __m256i out1=_mm256_or_si256(_mm256_cmpgt_epi64(lo,r1),_mm256_cmpgt_epi64(r1,hi));
+        unsigned bits=(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(ok));
+        unsigned out=(unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(out0)) |
+                     (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(out1))<<4;
+        m|=(uint64_t)(bits&~out)<<i;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i zero=_mm_setzero_si128();
+    const __m128i want=_mm_set1_epi32(f->status);
+    const __m128i any=_mm_set1_epi32(f->status<0?-1:0);
+    const __m128i beds=_mm_set1_epi32(f->min_bedrooms), baths=_mm_set1_epi32(f->min_bathrooms);
+    const __m128i lo=_mm_set_epi32((int)(f->rent_lo>>32),(int)(uint32_t)f->rent_lo,
+                                   (int)(f->rent_lo>>32),(int)(uint32_t)f->rent_lo);
+    const __m128i hi=_mm_set_epi32((int)(f->rent_hi>>32),(int)(uint32_t)f->rent_hi,
+                                   (int)(f->rent_hi>>32),(int)(uint32_t)f->rent_hi);
+    for(; i+4<=n; i+=4){
+        int s=from+i;
+        int packed;
+        memcpy(&packed,c->status+s,sizeof(packed));
+        __m128i st=_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed),zero),zero);
+        __m128i ok=_mm_or_si128(_mm_cmpeq_epi32(st,want),any);
+        __m128i v=_mm_loadu_si128((const __m128i*)(c->bedrooms+s));
+        ok=_mm_andnot_si128(_mm_cmpgt_epi32(beds,v),ok);
+        v=_mm_loadu_si128((const __m128i*)(c->bathrooms+s));
+        ok=_mm_andnot_si128(_mm_cmpgt_epi32(baths,v),ok);
+        __m128i r0=_mm_loadu_si128((const __m128i*)(c->rent_cents+s));
+        __m128i r1=_mm_loadu_si128((const __m128i*)(c->rent_cents+s+2));
+        __m128i out0=_mm_or_si128(cmpgt_epi64_sse2(lo,r0),cmpgt_epi64_sse2(r0,hi));
+        __m128i out1=_mm_or_si128(cmpgt_epi64_sse2(lo,r1),cmpgt_epi64_sse2(r1,hi));
+        unsigned bits=(unsigned)_mm_movemask_ps(_mm_castsi128_ps(ok));
+        unsigned out=(unsigned)_mm_movemask_pd(_mm_castsi128_pd(out0)) |
+                     (unsigned)_mm_movemask_pd(_mm_castsi128_pd(out1))<<2;
+        m|=(uint64_t)(bits&~out)<<i;
+    }
+#endif
+    if(i<n) m|=select_numeric_scalar(c,f,from+i,n-i)<<i;
+    return m;
+}
+
+// ------------- Filtered Search ------------
+// A conjunctive house query. The planner sizes every index that can supply
+// candidates for it, drives the scan from the cheapest, and checks the other
+// predicates batch by batch over a selection vector of slots. Cost is rows
+// times a per-path weight: a full scan runs the numeric kernels over the
+// house columns, while index paths jump between rows (measured at 1M houses:
+// ~5 ns per scanned row, ~60 per facet row and ~255 per rent-index row, where
+// the skip-list walk itself dominates). The status bitmap feeds the same
+// kernels a word at a time, so it only pays off once set bits are sparse
+// enough to skip whole words; below ~3% density each bit costs about one
+// 64-row kernel step.
+#define QUERY_BATCH 256
+
+typedef struct {
+    char   city[CITY_KEY_MAX];   // normalized; "" = any
+    char   area[CITY_KEY_MAX];
+    int    min_bedrooms, min_bathrooms;
+    double rent_lo, rent_hi;     // rent_hi < 0: no upper bound
+    int    status;               // -1 = any
+    int    landlord_id;          // 0 = any
+} HouseQuery;
+
+typedef enum { PATH_SCAN, PATH_STATUS, PATH_LANDLORD, PATH_CITY, PATH_AREA, PATH_RENT, PATH_COUNT } AccessPath;
+
+static const char* const path_names[PATH_COUNT]={
+    "full scan","status bitmap","landlord index","city facet","area facet","rent index"
+};
+static const int path_weight[PATH_COUNT]={ 1, 32, 12, 12, 12, 50 };
+
+typedef struct {
+    AccessPath path;
+    long  est[PATH_COUNT];       // candidate rows per path; -1 = not usable
+    long  cost;                  // est * weight of the chosen path
+    const IdList* city;          // facet lists, NULL when not constrained
+    const IdList* area;
+    const IdList* landlord;
+    int   city_id, area_id;      // the same keys as facet ids on the house rows
+    bool  columnar;              // slots come in order; numeric checks run as kernels
+    NumericFilter numeric;
+    bool  empty;                 // a key is unknown, so nothing can match
+    long  examined, matched;
+} QueryPlan;
+
+static bool query_has_rent(const HouseQuery* q){ return q->rent_lo>0 || q->rent_hi>=0; }
+
+// The numeric conditions of q in column units. Rents and bounds compare at
+// cent precision, which is all the files keep.
+// Rent bound in cents, rounded inward so a cent-valued rent passes exactly
+// when it passes the double comparison.
+static int64_t rent_bound_cents(double rent, bool upper){
+    int64_t c=rent_cents(rent);
+    if(upper){ if(c>INT64_MIN+1 && (double)c/100.0>rent) c--; }
+    else if(c<INT64_MAX && (double)c/100.0<rent) c++;
+    return c;
+}
+
+static void numeric_filter(const HouseQuery* q, NumericFilter* f){
+    bool rent=query_has_rent(q);
+    f->status=q->status;
+    f->min_bedrooms = q->min_bedrooms>0?q->min_bedrooms:INT32_MIN;
+    f->min_bathrooms = q->min_bathrooms>0?q->min_bathrooms:INT32_MIN;
+    f->rent_lo = rent?rent_bound_cents(q->rent_lo,false):INT64_MIN;
+    f->rent_hi = (rent && q->rent_hi>=0)?rent_bound_cents(q->rent_hi,true):INT64_MAX;
+}
+
+// Houses in the rent range, counting no further than cap.
+static long rent_range_count(const HouseQuery* q, long cap){
+    long n=0;
+    for(RentNode* r=rent_seek(q->rent_lo,INT_MIN); r && n<cap; r=r->next[0]){
+        if(q->rent_hi>=0 && r->rent>q->rent_hi) break;
+        n++;
+    }
+    return n;
+}
+
+static void plan_query(const HouseQuery* q, QueryPlan* pl){
+    memset(pl,0,sizeof(*pl));
+    for(int p=0;p<PATH_COUNT;p++) pl->est[p]=-1;
+    pl->est[PATH_SCAN]=house_count;
+    unsigned b;
+    if(q->status>=0) pl->est[PATH_STATUS]=bitmap_count(&status_bits[q->status],house_count);
+    if(q->landlord_id){
+        pl->landlord=multi_get(&landlord_houses,q->landlord_id);
+        pl->est[PATH_LANDLORD]=pl->landlord?pl->landlord->len:0;
+        pl->empty|=!pl->landlord;
+    }
+    if(q->city[0]){
+        int c=dict_find(&city_facet.dict,q->city,name_hash(q->city),&b);
+        pl->city_id=c;
+        pl->city=(c>=0)?multi_get(&city_facet.houses,c):NULL;
+        pl->est[PATH_CITY]=pl->city?pl->city->len:0;
+        pl->empty|=!pl->city;
+    }
+    if(q->city[0] && q->area[0]){
+        char key[AREA_KEY_MAX];
+        area_key(key,q->city,q->area);
+        int a=dict_find(&area_facet.dict,key,name_hash(key),&b);
+        pl->area_id=a;
+        pl->area=(a>=0)?multi_get(&area_facet.houses,a):NULL;
+        pl->est[PATH_AREA]=pl->area?pl->area->len:0;
+        pl->empty|=!pl->area;
+    }
+    pl->path=PATH_SCAN;
+    pl->cost=house_count;
+    for(int p=PATH_STATUS;p<PATH_RENT;p++){
+        if(pl->est[p]<0 || pl->est[p]*path_weight[p]>=pl->cost) continue;
+        pl->cost=pl->est[p]*path_weight[p];
+        pl->path=(AccessPath)p;
+    }
+    // The rent range has no stored size; walk it only as far as could still win.
+    if(query_has_rent(q)){
+        long cap=pl->cost/path_weight[PATH_RENT];
+        pl->est[PATH_RENT]=rent_range_count(q,cap+1);
+        if(pl->est[PATH_RENT]<=cap && pl->est[PATH_RENT]*path_weight[PATH_RENT]<pl->cost){
+            pl->cost=pl->est[PATH_RENT]*path_weight[PATH_RENT];
+            pl->path=PATH_RENT;
+        }
+    }
+    // Scan and status paths visit slots in order, so the numeric conditions
+    // run over the columns a word of slots at a time.
+    pl->columnar = pl->path==PATH_SCAN || pl->path==PATH_STATUS;
+    numeric_filter(q,&pl->numeric);
+}
+
+// Keep the slots of sel[0..n) that pass every predicate the access path does
+// not already guarantee; one tight loop per predicate. Columnar plans have
+// had the numeric ones applied by the kernel.
+static int filter_batch(const HouseQuery* q, const QueryPlan* pl, int* sel, int n){
+    int k;
+    if(q->status>=0 && !pl->columnar && pl->path!=PATH_STATUS){
+        k=0;
+        for(int i=0;i<n;i++) if((int)houses[sel[i]].status==q->status) sel[k++]=sel[i];
+        n=k;
+    }
+    if(q->landlord_id && pl->path!=PATH_LANDLORD){
+        k=0;
+        for(int i=0;i<n;i++) if(houses[sel[i]].landlord_id==q->landlord_id) sel[k++]=sel[i];
+        n=k;
+    }
+    if(q->min_bedrooms>0 && !pl->columnar){
+        k=0;
+        for(int i=0;i<n;i++) if(houses[sel[i]].bedrooms>=q->min_bedrooms) sel[k++]=sel[i];
+        n=k;
+    }
+    if(q->min_bathrooms>0 && !pl->columnar){
+        k=0;
+        for(int i=0;i<n;i++) if(houses[sel[i]].bathrooms>=q->min_bathrooms) sel[k++]=sel[i];
+        n=k;
+    }
+    if(query_has_rent(q) && !pl->columnar && pl->path!=PATH_RENT){
+        k=0;
+        for(int i=0;i<n;i++){
+            double r=houses[sel[i]].rent;
+            if(r>=q->rent_lo && (q->rent_hi<0 || r<=q->rent_hi)) sel[k++]=sel[i];
+        }
+        n=k;
+    }
+    if(pl->area && pl->path!=PATH_AREA){
+        k=0;
+        for(int i=0;i<n;i++) if(houses[sel[i]].area==pl->area_id) sel[k++]=sel[i];
+        n=k;
+    } else if(pl->city && pl->path!=PATH_CITY && pl->path!=PATH_AREA){
+        k=0;
+        for(int i=0;i<n;i++) if(houses[sel[i]].city==pl->city_id) sel[k++]=sel[i];
+        n=k;
+    }
+    return n;
+}
+
+typedef void (*HouseVisitor)(const HouseRow* h, void* ctx);
+
+// Run the plan and call visit for every matching house, in access-path order.
+static void run_query(const HouseQuery* q, QueryPlan* pl, HouseVisitor visit, void* ctx){
+    if(pl->empty) return;
+    int sel[QUERY_BATCH];
+    int n=0;
+    const IdList* list = pl->path==PATH_LANDLORD?pl->landlord : pl->path==PATH_CITY?pl->city :
+                         pl->path==PATH_AREA?pl->area : NULL;
+    RentNode* r = (pl->path==PATH_RENT)?rent_seek(q->rent_lo,INT_MIN):NULL;
+    const Bitmap* bm = (pl->path==PATH_STATUS)?&status_bits[q->status]:NULL;
+    int next=0;
+    bool more=true;
+    while(more){
+        // Fill one batch of candidate slots from the access path.
+        n=0;
+        if(pl->columnar){
+            // A word of slots at a time through the filter kernel; the status
+            // path skips empty bitmap words and keeps only set bits.
+            while(n<=QUERY_BATCH-64 && next<house_count){
+                int len = house_count-next<64 ? house_count-next : 64;
+                uint64_t m = len<64 ? (1ull<<len)-1 : ~0ull;
+                if(bm) m &= (next>>6)<bm->nwords ? bm->words[next>>6] : 0;
+                if(m){
+                    pl->examined += bm?popcount64(m):len;
+                    m &= select_numeric(&house_cols,&pl->numeric,next,len);
+                }
+                for(; m; m&=m-1) sel[n++]=next+(int)ctz64(m);
+                next+=len;
+            }
+            more = next<house_count;
+        } else {
+            if(pl->path==PATH_RENT){
+                for(; n<QUERY_BATCH && r && (q->rent_hi<0 || r->rent<=q->rent_hi); r=r->next[0])
+                    sel[n++]=idx_get(&house_index,r->id);
+            } else {
+                while(n<QUERY_BATCH && next<list->len) sel[n++]=idx_get(&house_index,list->ids[next++]);
+            }
+            pl->examined+=n;
+            more = n>0;
+        }
+        n=filter_batch(q,pl,sel,n);
+        pl->matched+=n;
+        for(int i=0;i<n;i++) visit(&houses[sel[i]],ctx);
+    }
+}
+
+static void print_plan(const QueryPlan* pl, double ms){
+    printf(CYAN "EXPLAIN" RESET " access path: %s\n",path_names[pl->path]);
+    for(int p=0;p<PATH_COUNT;p++){
+        if(pl->est[p]<0) continue;
+        bool capped=(p==PATH_RENT && pl->path!=PATH_RENT);
+        printf("  %-14s %s%ld rows, cost %s%ld%s\n",path_names[p],capped?">":"",pl->est[p]-capped,
+               capped?">":"",(pl->est[p]-capped)*path_weight[p],p==(int)pl->path?"  <- chosen":"");
+    }
+    printf("  examined %ld, matched %ld, %.3f ms%s\n",pl->examined,pl->matched,ms,
+           pl->empty?" (unknown key, nothing to scan)":"");
+}
+
+typedef struct { int shown; } PrintCtx;
+
+static void print_match(const HouseRow* h, void* ctx){
+    PrintCtx* pc=(PrintCtx*)ctx;
+    if(pc->shown++<BROWSE_PAGE_SIZE) print_browse_row(h);
+}
+
+static void read_house_query(HouseQuery* q){
+    char line[64];
+    memset(q,0,sizeof(*q));
+    printf(YELLOW "Leave blank for any.\n" RESET);
+    input_line("City: ",line,sizeof(line));
+    normalize_key(q->city,sizeof(q->city),line);
+    input_line("Area: ",line,sizeof(line));
+    normalize_key(q->area,sizeof(q->area),line);
+    q->min_bedrooms  = read_int_range("Min bedrooms: ",0,50,0,true);
+    q->min_bathrooms = read_int_range("Min bathrooms: ",0,50,0,true);
+    q->rent_lo = read_double_nonneg("Min rent: ",0,true);
+    q->rent_hi = read_double_nonneg("Max rent: ",-1,true);
+    printf("Status: 0=Available, 1=Rented, 2=Maintenance, 3=Any\n");
+    q->status = read_int_range("Status (blank 0): ",0,3,0,true);
+    if(q->status==3) q->status=-1;
+    q->landlord_id = read_int_range("Landlord ID: ",0,2147483647,0,true);
+    if(q->area[0] && !q->city[0]) printf(YELLOW "Area needs a city; ignoring it.\n" RESET);
+    if(!q->city[0]) q->area[0]='\0';
+}
+
+static void tenant_search_houses(void){
+    HouseQuery q;
+    read_house_query(&q);
+    QueryPlan pl;
+    double t0=now_seconds();
+    plan_query(&q,&pl);
+    printf("\n");
+    print_browse_header();
+    PrintCtx pc={0};
+    run_query(&q,&pl,print_match,&pc);
+    double ms=(now_seconds()-t0)*1e3;
+    if(pc.shown>BROWSE_PAGE_SIZE) printf("... %d more\n",pc.shown-BROWSE_PAGE_SIZE);
+    print_plan(&pl,ms);
+}
+
+// Faceted browse: available counts per city, then per area of the chosen
+// city, then the matching houses from that facet's list.
+static void tenant_browse_by_location(void){
+    printf(CYAN "\n-- Available by City --\n" RESET);
+    printf("%-24s | %9s\n","City","Available");
+    for(int c=0;c<city_facet.dict.count;c++)
+        if(city_facet.available[c]>0)
+            printf("%-24s | %9d\n",city_facet.dict.labels[c],city_facet.available[c]);
+
+    char input[64], key[AREA_KEY_MAX];
+    unsigned b;
+    input_line("City (blank to go back): ",input,sizeof(input));
+    normalize_key(key,CITY_KEY_MAX,input);
+    if(!key[0]) return;
+    int c=dict_find(&city_facet.dict,key,name_hash(key),&b);
+    if(c<0 || !city_facet.available[c]){
+        printf(YELLOW "No available houses in %s.\n" RESET,input);
+        return;
+    }
+
+    printf(CYAN "\n-- Available in %s by Area --\n" RESET,city_facet.dict.labels[c]);
+    printf("%-24s | %9s\n","Area","Available");
+    for(int a=0;a<area_facet.dict.count;a++)
+        if(area_facet.parent[a]==c && area_facet.available[a]>0)
+            printf("%-24s | %9d\n",area_facet.dict.labels[a],area_facet.available[a]);
+
+    const Facet* f=&city_facet;
+    int fid=c;
+    input_line("Area (blank for all): ",input,sizeof(input));
+    char city_key[CITY_KEY_MAX];
+    memcpy(city_key,key,sizeof(city_key));
+    area_key(key,city_key,input);
+    if(key[strlen(city_key)+1]){
+        f=&area_facet;
+        fid=dict_find(&area_facet.dict,key,name_hash(key),&b);
+        if(fid<0 || !area_facet.available[fid]){
+            printf(YELLOW "No available houses in %s.\n" RESET,input);
+            return;
+        }
+    }
+
+    const IdList* l=multi_get(&f->houses,fid);
+    printf("Order: 0=By ID, 1=Cheapest first, 2=Most expensive first\n");
+    int order=read_int_range("Order (blank 0): ",0,2,0,true);
+    if(order==0){
+        int shown=0;
+        printf("\n");
+        print_browse_header();
+        for(int i=0; l && i<l->len; i++){
+            const HouseRow* h=find_house_by_id(l->ids[i]);
+            if(h->status!=STATUS_AVAILABLE) continue;
+            if(shown && shown%BROWSE_PAGE_SIZE==0){
+                char line[8];
+                input_line("Enter for next page, q to stop: ",line,sizeof(line));
+                if(line[0]=='q' || line[0]=='Q') return;
+                print_browse_header();
+            }
+            print_browse_row(h);
+            shown++;
+        }
+        printf("%d available\n",f->available[fid]);
+        return;
+    }
+
+    // "Cheapest 20 in Dhaka": one pass over the facet list into a bounded heap.
+    int k=read_int_range("How many (blank 20): ",1,TOP_K_MAX,BROWSE_PAGE_SIZE,true);
+    TopItem best[TOP_K_MAX];
+    TopK top={best,0,k,order==2};
+    for(int i=0; l && i<l->len; i++){
+        const HouseRow* h=find_house_by_id(l->ids[i]);
+        if(h->status==STATUS_AVAILABLE) top_offer(&top,h->rent,h->id);
+    }
+    top_finish(&top);
+    printf(CYAN "\n-- %s %d of %d available --\n" RESET,
+           order==2?"Most expensive":"Cheapest",top.len,f->available[fid]);
+    print_browse_header();
+    for(int i=0;i<top.len;i++) print_browse_row(find_house_by_id(best[i].id));
+}
+
+// Full listing of one house; the only tenant view that reads the cold text
+// beyond the title, city and area.
+static void tenant_view_house_details(void){
+    int id = read_int_range("House ID: ",1,2147483647,0,false);
+    const HouseRow* h = find_house_by_id(id);
+    if(!h){
+        printf(RED "House not found.\n" RESET);
+        return;
+    }
+    const HouseText* t=text_of(h);
+    printf(CYAN "\n-- %s --\n" RESET, house_str(t->title));
+    printf("Address  : %s, %s, %s\n", house_str(t->address), sym_str(t->area_sym), sym_str(t->city_sym));
+    printf("Rooms    : %d bedroom(s), %d bathroom(s)\n", h->bedrooms, h->bathrooms);
+    printf("Rent     : %.2f / month\n", h->rent);
+    printf("Status   : %s\n", status_str(h->status));
+    printf("Landlord : %s\n", sym_str(t->landlord_sym));
+    printf("Listed   : %s\n", t->date_added);
+    printf("%s\n", house_str(t->description));
+}
+
+static void tenant_view_my_rentals(const User* t){
+    printf(CYAN "\n-- My Rentals --\n" RESET);
+    printf("%-4s | %-18s | %-10s | %-6s | %-9s\n","ID","House","StartDate","Active","Rent");
+    const IdList* mine=multi_get(&tenant_rentals,t->id);
+    for(int i=0; mine && i<mine->len; i++){
+        const Rental* r=find_rental_by_id(mine->ids[i]);
+        printf("%-4d | %-18s | %-10s | %-6s | %9.2f\n",
+               r->id, rental_title(r), r->rental_date,
+               r->is_active?"Yes":"No", r->monthly_rent);
+    }
+}
+
+static void tenant_rent_house(User* t){
+    int hid = read_int_range("Enter House ID to rent: ",1,2147483647,0,false);
+    HouseRow* h = find_house_by_id(hid);
+    if(!h || h->status!=STATUS_AVAILABLE){
+        printf(RED "House not found or not available.\n" RESET);
+        return;
+    }
+    // The status can be set back to Available by hand while a booking is live.
+    if(idx_get(&house_active_rental,hid)>=0){
+        printf(RED "House already has an active rental.\n" RESET);
+        return;
+    }
+
+    Rental r;
+    memset(&r,0,sizeof(r));
+    r.id = next_rental_id();
+    r.house_id = h->id;
+    r.tenant_id= t->id;
+    r.landlord_id = h->landlord_id;
+    strncpy(r.rental_date, today(), sizeof(r.rental_date)-1);
+    r.rental_date[sizeof(r.rental_date)-1] = '\0';
+    r.monthly_rent = h->rent;
+    r.is_active = true;
+
+    add_rental(&r);
+    set_house_status(h,STATUS_RENTED);
+    journal_rental('I',&r);
+    journal_house('U',h);
+    printf(GREEN "Rental created. Rental ID %d\n" RESET, r.id);
+}
+
+static void tenant_end_rental(User* t){
+    int rid = read_int_range("Rental ID to end: ",1,2147483647,0,false);
+    Rental* r = find_rental_by_id(rid);
+    if(!r || r->tenant_id!=t->id){
+        printf(RED "Rental not found or not yours.\n" RESET);
+        return;
+    }
+    if(!r->is_active){
+        printf(YELLOW "Rental already inactive.\n" RESET);
+        return;
+    }
+    unindex_rental_active(r);
+    r->is_active=false;
+    HouseRow* h = find_house_by_id(r->house_id);
+    if(h && h->status==STATUS_RENTED) set_house_status(h,STATUS_AVAILABLE);
+    journal_rental('U',r);
+    if(h) journal_house('U',h);
+    printf(GREEN "Rental ended.\n" RESET);
+}
+
+// --------------- Bulk Import --------------
+// Non-interactive loader for agency onboarding. Input files are CSV (with
+// "quoted" fields) or pipe-delimited, detected from the first line; an
+// optional header row is skipped. Ids are assigned here, never read:
+//   users:   username,password,full_name,email,phone,role[,active]
+//   houses:  title,address,city,area,bedrooms,bathrooms,rent,description,landlord_id[,status]
+//   rentals: house_id,tenant_id,rental_date,monthly_rent[,active]
+// Each table is written once at the end instead of once per row.
+#define IMPORT_LINE_MAX 4096
+#define IMPORT_MAX_COLS 12
+
+typedef struct { long accepted, rejected; } ImportStats;
+
+// Split line in place; returns the column count or -1 on a malformed quote.
+static int split_import_line(char* line, char delim, char** cols, int max){
+    int n=0;
+    char* p=line;
+    for(;;){
+        if(n==max) return n+1;   // too many columns
+        char* out=p;
+        cols[n++]=out;
+        if(delim==',' && *p=='"'){
+            p++;
+            for(;;){
+                if(*p=='\0') return -1;
+                if(*p=='"'){
+                    if(p[1]=='"'){ *out++='"'; p+=2; continue; }
+                    p++;
+                    break;
+                }
+                *out++=*p++;
+            }
+            if(*p!=delim && *p!='\0') return -1;
+        } else {
+            while(*p && *p!=delim) *out++=*p++;
+        }
+        bool more=(*p==delim);
+        *out='\0';
+        if(!more) return n;
+        p++;
+    }
+}
+
+// Text fields must survive the pipe format: non-empty, no '|', and short
+// enough that the loader will not reject them.
+static const char* check_text(const char* v, size_t cap){
+    if(!v[0]) return "empty field";
+    if(strchr(v,'|')) return "field contains '|'";
+    if(strlen(v)>cap-1) return "field too long";
+    return NULL;
+}
+
+static bool parse_import_int(const char* v, int minv, int maxv, int* out){
+    char* end;
+    long x=strtol(v,&end,10);
+    if(end==v || *end!='\0' || x<minv || x>maxv) return false;
+    *out=(int)x;
+    return true;
+}
+
+static bool parse_import_double(const char* v, double* out){
+    char* end;
+    double x=strtod(v,&end);
+    if(end==v || *end!='\0' || !(x>=0.0)) return false;
+    *out=x;
+    return true;
+}
+
+static void copy_field(char* dst, size_t cap, const char* src){
+    strncpy(dst,src,cap-1);
+    dst[cap-1]='\0';
+}
+
+static const char* import_user_row(char** c, int n, int* next_id){
+    if(n!=6 && n!=7) return "expected 6 or 7 columns";
+    const char* err;
+    if((err=check_text(c[0],USERNAME_MAX))) return err;
+    if((err=check_text(c[1],PASSWORD_MAX))) return err;
+    if((err=check_text(c[2],FULL_NAME_MAX))) return err;
+    if((err=check_text(c[3],EMAIL_MAX))) return err;
+    if((err=check_text(c[4],PHONE_MAX))) return err;
+    if(!is_valid_email(c[3])) return "invalid email";
+    if(!is_valid_phone(c[4])) return "invalid phone";
+    int role, active=1;
+    if(!parse_import_int(c[5],0,2,&role)) return "role must be 0..2";
+    if(n==7 && !parse_import_int(c[6],0,1,&active)) return "active must be 0 or 1";
+    if(find_user_by_username(c[0])) return "duplicate username";
+
+    User u;
+    memset(&u,0,sizeof(u));
+    u.id=(*next_id)++;
+    user_set_text(&u,c[0],c[1],c[2],c[3],c[4]);
+    u.role=(UserRole)role;
+    u.is_active=(bool)active;
+    add_user(&u);
+    return NULL;
+}
+
+static const char* import_house_row(char** c, int n, int* next_id){
+    if(n!=9 && n!=10) return "expected 9 or 10 columns";
+    const char* err;
+    if((err=check_text(c[0],sizeof(((House*)0)->title)))) return err;
+    if((err=check_text(c[1],sizeof(((House*)0)->address)))) return err;
+    if((err=check_text(c[2],sizeof(((House*)0)->city)))) return err;
+    if((err=check_text(c[3],sizeof(((House*)0)->area)))) return err;
+    if((err=check_text(c[7],sizeof(((House*)0)->description)))) return err;
+    int bedrooms, bathrooms, landlord_id, status=STATUS_AVAILABLE;
+    double rent;
+    if(!parse_import_int(c[4],0,50,&bedrooms)) return "bedrooms must be 0..50";
+    if(!parse_import_int(c[5],0,50,&bathrooms)) return "bathrooms must be 0..50";
+    if(!parse_import_double(c[6],&rent)) return "rent must be a number >= 0";
+    if(!parse_import_int(c[8],1,2147483647,&landlord_id)) return "bad landlord_id";
+    if(n==10 && !parse_import_int(c[9],0,2,&status)) return "status must be 0..2";
+    const User* owner=find_user_by_id(landlord_id);
+    if(!owner || owner->role!=ROLE_LANDLORD) return "landlord_id is not a landlord";
+
+    House h;
+    memset(&h,0,sizeof(h));
+    h.id=(*next_id)++;
+    copy_field(h.title,sizeof(h.title),c[0]);
+    copy_field(h.address,sizeof(h.address),c[1]);
+    copy_field(h.city,sizeof(h.city),c[2]);
+    copy_field(h.area,sizeof(h.area),c[3]);
+    h.bedrooms=bedrooms;
+    h.bathrooms=bathrooms;
+    h.rent=round_rent(rent);
+    copy_field(h.description,sizeof(h.description),c[7]);
+    h.landlord_id=landlord_id;
+    copy_field(h.landlord_name,sizeof(h.landlord_name),user_str(owner->full_name));
+    h.status=(HouseStatus)status;
+    copy_field(h.date_added,sizeof(h.date_added),today());
+    add_house(&h);
+    return NULL;
+}
+
+static const char* import_rental_row(char** c, int n, int* next_id){
+    if(n!=4 && n!=5) return "expected 4 or 5 columns";
+    int house_id, tenant_id, active=1;
+    double rent;
+    if(!parse_import_int(c[0],1,2147483647,&house_id)) return "bad house_id";
+    if(!parse_import_int(c[1],1,2147483647,&tenant_id)) return "bad tenant_id";
+    const char* err;
+    if((err=check_text(c[2],sizeof(((Rental*)0)->rental_date)))) return err;
+    if(!parse_import_double(c[3],&rent)) return "monthly_rent must be a number >= 0";
+    if(n==5 && !parse_import_int(c[4],0,1,&active)) return "active must be 0 or 1";
+    HouseRow* h=find_house_by_id(house_id);
+    if(!h) return "unknown house_id";
+    const User* t=find_user_by_id(tenant_id);
+    if(!t || t->role!=ROLE_TENANT) return "tenant_id is not a tenant";
+    if(active && (h->status!=STATUS_AVAILABLE || idx_get(&house_active_rental,house_id)>=0))
+        return "house not available";
+
+    Rental r;
+    memset(&r,0,sizeof(r));
+    r.id=(*next_id)++;
+    r.house_id=house_id;
+    r.tenant_id=tenant_id;
+    r.landlord_id=h->landlord_id;
+    copy_field(r.rental_date,sizeof(r.rental_date),c[2]);
+    r.monthly_rent=rent;
+    r.is_active=(bool)active;
+    add_rental(&r);
+    if(active) set_house_status(h,STATUS_RENTED);
+    return NULL;
+}
+
+static bool import_file(TableId t, const char* path, ImportStats* st){
+    static const char* const first_col[TABLE_COUNT]={"username","title","house_id"};
+    MappedFile mf;
+    if(!map_file(path,&mf)){
+        fprintf(stderr,"Cannot open %s\n",path);
+        return false;
+    }
+    const char* end=mf.data+mf.size;
+    // One id per line at most; the unused tail is released at the end.
+    int rows=1;
+    for(const char* p=mf.data; (p=memchr(p,'\n',(size_t)(end-p)))!=NULL; p++) rows++;
+    int next_id=reserve_ids(t,rows);
+    char delim=0;
+    long lineno=0;
+    char line[IMPORT_LINE_MAX];
+    for(const char* p=mf.data; p<end; ){
+        const char* nl=memchr(p,'\n',(size_t)(end-p));
+        const char* eol=nl?nl:end;
+        size_t len=(size_t)(eol-p);
+        const char* row=p;
+        p=nl?nl+1:end;
+        lineno++;
+        if(len && row[len-1]=='\r') len--;
+        if(len==0) continue;
+        if(!delim) delim = memchr(row,'|',len)?'|':',';
+
+        const char* err=NULL;
+        char* cols[IMPORT_MAX_COLS];
+        int n=0;
+        if(len>=sizeof(line)) err="line too long";
+        else {
+            memcpy(line,row,len);
+            line[len]='\0';
+            n=split_import_line(line,delim,cols,IMPORT_MAX_COLS);
+            if(n<0) err="unbalanced quotes";
+        }
+        if(!err && lineno==1 && strcmp(cols[0],first_col[t])==0) continue;   // header row
+        if(!err){
+            if(t==TABLE_USERS) err=import_user_row(cols,n,&next_id);
+            else if(t==TABLE_HOUSES) err=import_house_row(cols,n,&next_id);
+            else err=import_rental_row(cols,n,&next_id);
+        }
+        if(err){
+            printf("  %s:%ld: %s\n",path,lineno,err);
+            st->rejected++;
+        } else {
+            st->accepted++;
+        }
+    }
+    release_ids(t,next_id);
+    unmap_file(&mf);
+    return true;
+}
+
+// project --import <users|houses|rentals> <file> [...]; users are imported
+// first and rentals last so rows can refer to records from the same run.
+static int run_import(int argc, char** argv){
+    static const char* const kinds[TABLE_COUNT]={"users","houses","rentals"};
+    if(argc<4 || (argc-2)%2!=0){
+        fprintf(stderr,"Usage: %s --import <users|houses|rentals> <file> [...]\n",argv[0]);
+        return 2;
+    }
+    for(int i=2;i<argc;i+=2){
+        int k=0;
+        while(k<TABLE_COUNT && strcmp(argv[i],kinds[k])!=0) k++;
+        if(k==TABLE_COUNT){
+            fprintf(stderr,"Unknown table '%s'\n",argv[i]);
+            return 2;
+        }
+    }
+
+    load_all();
+    int status=0;
+    for(int t=0;t<TABLE_COUNT;t++){
+        for(int i=2;i<argc;i+=2){
+            if(strcmp(argv[i],kinds[t])!=0) continue;
+            ImportStats st={0,0};
+            printf("Importing %s from %s\n",kinds[t],argv[i+1]);
+            double t0=now_seconds();
+            if(!import_file((TableId)t,argv[i+1],&st)){ status=1; continue; }
+            double secs=now_seconds()-t0;
+            printf("%s: %ld accepted, %ld rejected in %.3fs (%.0f rows/s)\n",
+                   kinds[t],st.accepted,st.rejected,secs,
+                   secs>0?(st.accepted+st.rejected)/secs:0.0);
+            if(st.rejected) status=1;
+        }
+    }
+    double t0=now_seconds();
+    save_all();
+    printf("Tables written in %.3fs\n",now_seconds()-t0);
+    return status;
+}
+
+// ------------- Filter Benchmark -----------
+// --bench-filter [rows]: time the filter kernels on synthetic house columns
+// on one thread, next to the scalar kernel and a row-at-a-time check over
+// HouseRow, and report rows per second. Nothing is loaded or written.
+#if defined(__AVX2__)
+  #define FILTER_KERNEL "AVX2"
+#elif defined(__SSE2__) || defined(_M_X64)
+  #define FILTER_KERNEL "SSE2"
+#else
+  #define FILTER_KERNEL "scalar"
+#endif
+
+typedef uint64_t (*SelectFn)(const HouseColumns*, const NumericFilter*, int, int);
+
+static long bench_rows_kernel(SelectFn fn, const HouseColumns* c, const NumericFilter* f, int rows){
+    long hits=0;
+    for(int from=0;from<rows;from+=64)
+        hits+=popcount64(fn(c,f,from,rows-from<64?rows-from:64));
+    return hits;
+}
+
+// The pre-column check: branchy, over whole rows, rent as a double.
+static long bench_rows_aos(const HouseRow* r, const NumericFilter* f, int rows){
+    double lo = f->rent_lo==INT64_MIN ? -HUGE_VAL : (double)f->rent_lo/100.0;
+    double hi = f->rent_hi==INT64_MAX ? HUGE_VAL : (double)f->rent_hi/100.0;
+    long hits=0;
+    for(int i=0;i<rows;i++){
+        const HouseRow* h=&r[i];
+        if((f->status<0 || (int)h->status==f->status) && h->bedrooms>=f->min_bedrooms &&
+           h->bathrooms>=f->min_bathrooms && h->rent>=lo && h->rent<=hi) hits++;
+    }
+    return hits;
+}
+
+// Millions of rows per second for one of the three loops, best of a few runs.
+static double bench_rate(int which, const HouseColumns* c, const HouseRow* r,
+                         const NumericFilter* f, int rows, long* hits){
+    double best=0;
+    for(int run=0;run<5;run++){
+        double t0=now_seconds();
+        *hits = which==0 ? bench_rows_kernel(select_numeric,c,f,rows) :
+                which==1 ? bench_rows_kernel(select_numeric_scalar,c,f,rows) : bench_rows_aos(r,f,rows);
+        double secs=now_seconds()-t0;
+        if(secs>0 && rows/secs/1e6>best) best=rows/secs/1e6;
+    }
+    return best;
+}
+
+static int run_filter_bench(int argc, char** argv){
+    int rows = argc>2 ? atoi(argv[2]) : 2000000;
+    if(rows<64){
+        fprintf(stderr,"Usage: %s --bench-filter [rows >= 64]\n",argv[0]);
+        return 2;
+    }
+    HouseColumns c;
+    c.bedrooms=malloc((size_t)rows*sizeof(int32_t));
+    c.bathrooms=malloc((size_t)rows*sizeof(int32_t));
+    c.rent_cents=malloc((size_t)rows*sizeof(int64_t));
+    c.status=malloc((size_t)rows*sizeof(uint8_t));
+    HouseRow* r=calloc((size_t)rows,sizeof(HouseRow));
+    if(!c.bedrooms || !c.bathrooms || !c.rent_cents || !c.status || !r){
+        fprintf(stderr,"Out of memory\n");
+        return 1;
+    }
+    srand(1);
+    for(int i=0;i<rows;i++){
+        r[i].id=i+1;
+        r[i].bedrooms=c.bedrooms[i]=rand()%7;
+        r[i].bathrooms=c.bathrooms[i]=1+rand()%4;
+        r[i].rent=(double)(rand()%1000000)/100.0;
+        c.rent_cents[i]=rent_cents(r[i].rent);
+        r[i].status=(HouseStatus)(rand()%3);
+        c.status[i]=(uint8_t)r[i].status;
+    }
+    static const struct { const char* name; NumericFilter f; } cases[]={
+        {"available",                        {STATUS_AVAILABLE,INT32_MIN,INT32_MIN,INT64_MIN,INT64_MAX}},
+        {"available, 2+ bed, 2000-5000",     {STATUS_AVAILABLE,2,INT32_MIN,200000,500000}},
+        {"any status, 3+ bed, 2+ bath, <=1500",{-1,3,2,0,150000}},
+        {"rented, 6+ bed, 4+ bath, <=100",   {STATUS_RENTED,6,4,0,10000}},
+    };
+    printf("Filter kernel: %s, %d rows, one thread (M rows/s per core)\n",FILTER_KERNEL,rows);
+    printf("%-36s | %9s | %9s | %9s | %9s\n","Predicate","Kernel","Scalar","Row-wise","Matches");
+    for(size_t k=0;k<sizeof(cases)/sizeof(cases[0]);k++){
+        long h0, h1, h2;
+        double v=bench_rate(0,&c,r,&cases[k].f,rows,&h0);
+        double s=bench_rate(1,&c,r,&cases[k].f,rows,&h1);
+        double a=bench_rate(2,&c,r,&cases[k].f,rows,&h2);
+        printf("%-36s | %9.0f | %9.0f | %9.0f | %9ld%s\n",cases[k].name,v,s,a,h0,
+               (h0==h1 && h1==h2)?"":"  MISMATCH");
+    }
+    free(c.bedrooms); free(c.bathrooms); free(c.rent_cents); free(c.status); free(r);
+    return 0;
+}
+
+// ---------------- Benchmarks ---------------
+// The --bench-* modes build synthetic tables in memory and time one
+// operation against the code it replaced, on one thread. Nothing is read
+// from or written to the table files; a mode that needs a file on disk
+// writes its own scratch file and removes it.
+static const char* const bench_cities[]={
+    "Dhaka","Chittagong","Sylhet","Khulna","Rajshahi","Barisal","Rangpur","Mymensingh"
+};
+static const char* const bench_areas[]={
+    "Gulshan","Banani","Mirpur","Uttara","Dhanmondi","Mohammadpur","Bashundhara","Badda","Motijheel","Tejgaon"
+};
+static const char* const bench_words[]={
+    "bright","quiet","spacious","modern","family","balcony","garden","lift",
+    "parking","furnished","rooftop","corner","lake","view","gas","generator"
+};
+#define BENCH_WORDS ((int)(sizeof(bench_words)/sizeof(bench_words[0])))
+
+// Synthetic house number i (id i+1): twenty houses per landlord, eight
+// cities with ten areas each, a few words of description. Uses rand().
+static void bench_house(int i, House* h){
+    memset(h,0,sizeof(*h));
+    h->id=i+1;
+    snprintf(h->title,sizeof(h->title),"%s flat %d",bench_words[rand()%BENCH_WORDS],i+1);
+    snprintf(h->address,sizeof(h->address),"House %d, Road %d",rand()%200+1,rand()%50+1);
+    snprintf(h->city,sizeof(h->city),"%s",bench_cities[rand()%8]);
+    snprintf(h->area,sizeof(h->area),"%s",bench_areas[rand()%10]);
+    h->bedrooms=1+rand()%6;
+    h->bathrooms=1+rand()%4;
+    h->rent=500+rand()%9500+(rand()%100)/100.0;
+    size_t n=0;
+    for(int w=4+rand()%16; w>0 && n+20<sizeof(h->description); w--)
+        n+=(size_t)snprintf(h->description+n,sizeof(h->description)-n,"%s%s",n?" ":"",bench_words[rand()%BENCH_WORDS]);
+    h->landlord_id=1+i/20;
+    snprintf(h->landlord_name,sizeof(h->landlord_name),"Landlord %d",h->landlord_id);
+    h->status=(HouseStatus)(rand()%STATUS_COUNT);
+    snprintf(h->date_added,sizeof(h->date_added),"2024-%02d-%02d",1+rand()%12,1+rand()%28);
+}
+
+// Empty the house table (and its text) without freeing anything.
+static void bench_clear_houses(void){
+    house_count=0;
+    house_arena.len=house_arena.live=0;
+}
+
+// Replace the house table with rows synthetic houses, indexed by id, status
+// and rent (the facet and text indexes are left to the modes that use them).
+static void bench_fill_houses(int rows){
+    bench_clear_houses();
+    reserve_houses(rows);
+    srand(1);
+    for(int i=0;i<rows;i++){
+        House h;
+        bench_house(i,&h);
+        house_store(house_count++,&h);
+    }
+    reindex_houses();
+}
+
+// --bench-load [rows ...]: parse a generated houses file with the loader
+// this file used to have (fgets into a line buffer, then one 13-field
+// sscanf) and with the mapped in-place loader. Defaults to 10k and 1M
+// rows; pass 10000000 for the 10M case (about 1.5 GB of scratch file).
+#define BENCH_LOAD_FILE "bench_houses.tmp"
+
+static void bench_load_stdio(const char* path){
+    FILE* fp=fopen(path,"r");
+    if(!fp) return;
+    char line[2048];
+    while(fgets(line,sizeof(line),fp)){
+        House h;
+        memset(&h,0,sizeof(h));
+        int status;
+        if(sscanf(line,"%d|%99[^|]|%199[^|]|%49[^|]|%49[^|]|%d|%d|%lf|%499[^|]|%d|%99[^|]|%d|%19[^\n]",
+                  &h.id,h.title,h.address,h.city,h.area,&h.bedrooms,&h.bathrooms,&h.rent,
+                  h.description,&h.landlord_id,h.landlord_name,&status,h.date_added)==13){
+            h.status=(HouseStatus)status;
+            reserve_houses(house_count+1);
+            house_store(house_count++,&h);
+        }
+    }
+    fclose(fp);
+}
+
+// Seconds for the best of three loads of path; *rows gets the rows loaded.
+static double bench_load_time(void (*load)(const char*), const char* path, int* rows){
+    double best=HUGE_VAL;
+    for(int run=0;run<3;run++){
+        bench_clear_houses();
+        double t0=now_seconds();
+        load(path);
+        double secs=now_seconds()-t0;
+        if(secs<best) best=secs;
+    }
+    *rows=house_count;
+    return best;
+}
+
+static int run_load_bench(int argc, char** argv){
+    static const int default_rows[]={10000,1000000};
+    int nsizes = argc>2 ? argc-2 : 2;
+    for(int k=2;k<argc;k++)
+        if(atoi(argv[k])<=0){
+            fprintf(stderr,"Usage: %s --bench-load [rows ...]\n",argv[0]);
+            return 2;
+        }
+    printf("houses.txt load: up to %d thread(s) on files of %u MiB or more\n",
+           cpu_count()<LOAD_MAX_THREADS?cpu_count():LOAD_MAX_THREADS,PARALLEL_LOAD_BYTES>>20);
+    printf("%10s | %9s | %13s | %11s | %7s\n","Rows","File MiB","fgets/sscanf","mmap","Speedup");
+    for(int k=0;k<nsizes;k++){
+        int rows = argc>2 ? atoi(argv[k+2]) : default_rows[k];
+        FILE* fp=fopen(BENCH_LOAD_FILE,"w");
+        if(!fp){ perror(BENCH_LOAD_FILE); return 1; }
+        srand(1);
+        for(int i=0;i<rows;i++){
+            House h;
+            bench_house(i,&h);
+            fprintf(fp,"%d|%s|%s|%s|%s|%d|%d|%.2f|%s|%d|%s|%d|%s\n",
+                h.id,h.title,h.address,h.city,h.area,h.bedrooms,h.bathrooms,h.rent,
+                h.description,h.landlord_id,h.landlord_name,h.status,h.date_added);
+        }
+        long bytes=ftell(fp);
+        fclose(fp);
+        int n_stdio, n_mmap;
+        double t_stdio=bench_load_time(bench_load_stdio,BENCH_LOAD_FILE,&n_stdio);
+        double t_mmap=bench_load_time(load_houses_file,BENCH_LOAD_FILE,&n_mmap);
+        remove(BENCH_LOAD_FILE);
+        printf("%10d | %9.1f | %11.3f s | %9.3f s | %6.1fx%s\n",rows,bytes/1048576.0,
+               t_stdio,t_mmap,t_stdio/t_mmap,(n_stdio==rows && n_mmap==rows)?"":"  ROW COUNT MISMATCH");
+    }
+    bench_clear_houses();
+    return 0;
+}
+
+// --bench-lookup [rows ...]: random id lookups through find_house_by_id
+// next to the linear scan it replaced. Defaults to 1k, 100k and 1M houses.
+static HouseRow* bench_scan_house(int id){
+    for(int i=0;i<house_count;i++)
+        if(houses[i].id==id) return &houses[i];
+    return NULL;
+}
+
+// Nanoseconds per lookup over the first n of ids, best of three; *found
+// counts hits.
+static double bench_lookup_ns(HouseRow* (*find)(int), const int* ids, int n, long* found){
+    double best=HUGE_VAL;
+    for(int run=0;run<3;run++){
+        long hits=0;
+        double t0=now_seconds();
+        for(int k=0;k<n;k++)
+            if(find(ids[k])) hits++;
+        double ns=(now_seconds()-t0)*1e9/n;
+        if(ns<best) best=ns;
+        *found=hits;
+    }
+    return best;
+}
+
+static int run_lookup_bench(int argc, char** argv){
+    static const int default_rows[]={1000,100000,1000000};
+    int nsizes = argc>2 ? argc-2 : 3;
+    for(int k=2;k<argc;k++)
+        if(atoi(argv[k])<=0){
+            fprintf(stderr,"Usage: %s --bench-lookup [rows ...]\n",argv[0]);
+            return 2;
+        }
+    enum { LOOKUPS=1000000 };
+    int* ids=malloc(LOOKUPS*sizeof(int));
+    if(!ids){ fprintf(stderr,"Out of memory\n"); return 1; }
+    printf("find_house_by_id on random ids, one thread (ns per lookup)\n");
+    printf("%10s | %11s | %11s | %9s\n","Houses","Id index","Linear scan","Speedup");
+    for(int k=0;k<nsizes;k++){
+        int rows = argc>2 ? atoi(argv[k+2]) : default_rows[k];
+        bench_fill_houses(rows);
+        for(int i=0;i<LOOKUPS;i++)
+            ids[i]=1+(int)(((unsigned)rand()*((unsigned)RAND_MAX+1u)+(unsigned)rand())%(unsigned)rows);
+        // The scan gets about 2e8 row visits, so each size takes a similar time.
+        int scans = (int)(2e8/rows);
+        if(scans<20) scans=20;
+        if(scans>LOOKUPS) scans=LOOKUPS;
+        long hit_index, hit_scan;
+        double t_index=bench_lookup_ns(find_house_by_id,ids,LOOKUPS,&hit_index);
+        double t_scan=bench_lookup_ns(bench_scan_house,ids,scans,&hit_scan);
+        printf("%10d | %11.1f | %11.1f | %8.0fx%s\n",rows,t_index,t_scan,t_scan/t_index,
+               (hit_index==LOOKUPS && hit_scan==scans)?"":"  MISSED IDS");
+    }
+    free(ids);
+    bench_clear_houses();
+    reindex_houses();
+    return 0;
+}
+
+// --bench-login [users ...]: logins per second through the username index
+// next to the strcmp scan authenticate() used to do, for good credentials
+// and for the unknown name a registration checks. Defaults to 10k and 1M
+// users.
+static User* bench_scan_login(const char* uname, const char* pw){
+    for(int i=0;i<user_count;i++)
+        if(strcmp(user_str(users[i].username),uname)==0)
+            return strcmp(user_str(users[i].password),pw)==0?&users[i]:NULL;
+    return NULL;
+}
+
+static void bench_fill_users(int rows){
+    user_count=0;
+    user_arena.len=user_arena.live=0;
+    reserve_users(rows);
+    for(int i=0;i<rows;i++){
+        User* u=&users[user_count++];
+        char name[32], pw[32], full[48], email[48], phone[16];
+        snprintf(name,sizeof(name),"user%07d",i+1);
+        snprintf(pw,sizeof(pw),"pw%d",(i+1)*7919);
+        snprintf(full,sizeof(full),"Tenant %d",i+1);
+        snprintf(email,sizeof(email),"user%d@example.com",i+1);
+        snprintf(phone,sizeof(phone),"01%09d",i+1);
+        memset(u,0,sizeof(*u));
+        u->id=i+1;
+        u->role=ROLE_TENANT;
+        u->is_active=true;
+        user_set_text(u,name,pw,full,email,phone);
+        user_arena.live+=user_text_bytes(u);
+    }
+    reindex_users();
+    reindex_usernames();
+}
+
+// Credentials of n random users, 32 bytes per name and per password;
+// known=false gives names nobody has.
+static void bench_credentials(char (*names)[32], char (*pws)[32], int n, bool known){
+    srand(7);
+    for(int k=0;k<n;k++){
+        int i=(int)(((unsigned)rand()*((unsigned)RAND_MAX+1u)+(unsigned)rand())%(unsigned)user_count)+1;
+        snprintf(names[k],32,known?"user%07d":"new%07d",i);
+        snprintf(pws[k],32,"pw%d",i*7919);
+    }
+}
+
+// Checks per second over the first n credentials, best of three; *found
+// counts the users returned.
+static double bench_login_rate(User* (*login)(const char*, const char*), char (*names)[32],
+                               char (*pws)[32], int n, long* found){
+    double best=0;
+    for(int run=0;run<3;run++){
+        long hits=0;
+        double t0=now_seconds();
+        for(int k=0;k<n;k++)
+            if(login(names[k],pws[k])) hits++;
+        double secs=now_seconds()-t0;
+        if(secs>0 && n/secs>best) best=n/secs;
+        *found=hits;
+    }
+    return best;
+}
+
+static int run_login_bench(int argc, char** argv){
+    static const int default_rows[]={10000,1000000};
+    int nsizes = argc>2 ? argc-2 : 2;
+    for(int k=2;k<argc;k++)
+        if(atoi(argv[k])<=0){
+            fprintf(stderr,"Usage: %s --bench-login [users ...]\n",argv[0]);
+            return 2;
+        }
+    enum { LOGINS=200000 };
+    char (*names)[32]=malloc(LOGINS*sizeof(*names));
+    char (*pws)[32]=malloc(LOGINS*sizeof(*pws));
+    if(!names || !pws){ fprintf(stderr,"Out of memory\n"); return 1; }
+    printf("Credential checks, one thread (per second)\n");
+    printf("%10s | %-18s | %12s | %12s | %9s\n","Users","Case","Index","Scan","Speedup");
+    for(int k=0;k<nsizes;k++){
+        int rows = argc>2 ? atoi(argv[k+2]) : default_rows[k];
+        bench_fill_users(rows);
+        // The scan gets about 1e8 name compares for a miss.
+        int scans = (int)(1e8/rows);
+        if(scans<20) scans=20;
+        if(scans>LOGINS) scans=LOGINS;
+        for(int known=1;known>=0;known--){
+            long hit_index, hit_scan;
+            bench_credentials(names,pws,LOGINS,known);
+            double r_index=bench_login_rate(find_login,names,pws,LOGINS,&hit_index);
+            double r_scan=bench_login_rate(bench_scan_login,names,pws,scans,&hit_scan);
+            bool ok = known ? (hit_index==LOGINS && hit_scan==scans) : (hit_index==0 && hit_scan==0);
+            printf("%10d | %-18s | %12.0f | %12.0f | %8.0fx%s\n",rows,
+                   known?"login":"unknown name",r_index,r_scan,r_index/r_scan,ok?"":"  WRONG RESULT");
+        }
+    }
+    free(names);
+    free(pws);
+    user_count=0;
+    user_arena.len=user_arena.live=0;
+    reindex_users();
+    reindex_usernames();
+    return 0;
+}
+
+// --bench-browse [rows] [available %]: count and walk the available houses
+// through the status bitmap, next to the status scan over every row that
+// tenant_browse_available used to do. Defaults to 1M houses, 5% available.
+static long bench_scan_available(bool walk){
+    long n=0;
+    for(int i=0;i<house_count;i++)
+        if(houses[i].status==STATUS_AVAILABLE) n+=walk?houses[i].id:1;
+    return n;
+}
+
+static long bench_bitmap_available(bool walk){
+    const Bitmap* avail=&status_bits[STATUS_AVAILABLE];
+    if(!walk) return bitmap_count(avail,house_count);
+    long n=0;
+    for(int i=bitmap_next(avail,0,house_count); i>=0; i=bitmap_next(avail,i+1,house_count))
+        n+=houses[i].id;
+    return n;
+}
+
+// Microseconds per call, best of five; *result gets the call's result.
+static double bench_browse_us(long (*fn)(bool), bool walk, long* result){
+    double best=HUGE_VAL;
+    for(int run=0;run<5;run++){
+        double t0=now_seconds();
+        *result=fn(walk);
+        double us=(now_seconds()-t0)*1e6;
+        if(us<best) best=us;
+    }
+    return best;
+}
+
+static int run_browse_bench(int argc, char** argv){
+    int rows = argc>2 ? atoi(argv[2]) : 1000000;
+    int pct = argc>3 ? atoi(argv[3]) : 5;
+    if(rows<=0 || pct<0 || pct>100){
+        fprintf(stderr,"Usage: %s --bench-browse [rows] [available %%]\n",argv[0]);
+        return 2;
+    }
+    bench_fill_houses(rows);
+    srand(3);
+    for(int i=0;i<rows;i++){
+        houses[i].status = rand()%100<pct ? STATUS_AVAILABLE : (HouseStatus)(1+rand()%2);
+        house_cols.status[i]=(uint8_t)houses[i].status;
+    }
+    reindex_houses();
+    printf("Available houses, %d rows, %d%% available, one thread (us per call)\n",rows,pct);
+    printf("%-22s | %10s | %10s | %8s\n","Operation","Bitmap","Scan","Speedup");
+    for(int walk=0;walk<2;walk++){
+        long rb, rs;
+        double tb=bench_browse_us(bench_bitmap_available,walk,&rb);
+        double ts=bench_browse_us(bench_scan_available,walk,&rs);
+        printf("%-22s | %10.1f | %10.1f | %7.1fx%s\n",walk?"walk available slots":"count available",
+               tb,ts,ts/tb,rb==rs?"":"  MISMATCH");
+    }
+    bench_clear_houses();
+    reindex_houses();
+    return 0;
+}
+
+// --bench-search [rows]: text_search over synthetic listings whose
+// descriptions draw 34-74 words from a 5k-word Zipf vocabulary, timed per
+// query (best of 20, top BROWSE_PAGE_SIZE available), with each match count
+// checked against a tokenized scan of every house. Defaults to 1M houses.
+#define BENCH_VOCAB 5000
+
+// Vocabulary word of rank r (0 = most common): "x" plus base-26 letters.
+static void bench_vocab_word(int r, char* w){
+    int n=0;
+    w[n++]='x';
+    do { w[n++]=(char)('a'+r%26); r/=26; } while(r);
+    w[n]='\0';
+}
+
+// Rank drawn with probability proportional to 1/(rank+1); cdf has BENCH_VOCAB
+// cumulative weights.
+static int bench_zipf_rank(const double* cdf){
+    double u=((double)rand()/((double)RAND_MAX+1.0))*cdf[BENCH_VOCAB-1];
+    int lo=0, hi=BENCH_VOCAB-1;
+    while(lo<hi){
+        int mid=(lo+hi)/2;
+        if(cdf[mid]<u) lo=mid+1; else hi=mid;
+    }
+    return lo;
+}
+
+// Houses holding every term of query, of any status, found without the index.
+static long bench_scan_matches(const char* query){
+    int want[TEXT_QUERY_TERMS], nw=0;
+    char tok[TEXT_TERM_MAX];
+    for(const char* p=query; nw<TEXT_QUERY_TERMS && next_token(&p,tok); ){
+        unsigned b;
+        want[nw++]=dict_find(&text_index.terms,tok,name_hash(tok),&b);
+    }
+    long matched=0;
+    int ids[TEXT_DOC_TERMS_MAX];
+    for(int i=0;i<house_count;i++){
+        int n=house_terms(&house_text[i],ids,false);
+        bool all=true;
+        for(int q=0;q<nw && all;q++){
+            bool found=false;
+            for(int j=0;j<n && !found;j++) found=(ids[j]==want[q]);
+            all=found;
+        }
+        if(all) matched++;
+    }
+    return matched;
+}
+
+static int run_search_bench(int argc, char** argv){
+    int rows = argc>2 ? atoi(argv[2]) : 1000000;
+    if(rows<=0){
+        fprintf(stderr,"Usage: %s --bench-search [rows]\n",argv[0]);
+        return 2;
+    }
+    double* cdf=malloc(BENCH_VOCAB*sizeof(double));
+    if(!cdf){ fprintf(stderr,"Out of memory\n"); return 1; }
+    for(int r=0;r<BENCH_VOCAB;r++) cdf[r]=(r?cdf[r-1]:0.0)+1.0/(r+1);
+    bench_clear_houses();
+    reserve_houses(rows);
+    srand(1);
+    for(int i=0;i<rows;i++){
+        House h;
+        bench_house(i,&h);
+        size_t n=0;
+        for(int w=34+rand()%41; w>0; w--){
+            char word[8];
+            bench_vocab_word(bench_zipf_rank(cdf),word);
+            if(n+strlen(word)+2>sizeof(h.description)) break;
+            n+=(size_t)snprintf(h.description+n,sizeof(h.description)-n,"%s%s",n?" ":"",word);
+        }
+        house_store(house_count++,&h);
+    }
+    free(cdf);
+    reindex_houses();
+
+    double t0=now_seconds();
+    text_build();
+    double build=now_seconds()-t0;
+    size_t postings=0;
+    for(int t=0;t<text_index.terms.count;t++) postings+=(size_t)text_index.postings[t].cap*sizeof(Posting);
+    printf("Full-text search, %d houses, %d terms; index built in %.2f s, %.0f MiB of postings\n",
+           rows,text_index.terms.count,build,postings/1048576.0);
+
+    // Queries by vocabulary rank, from selective to very common.
+    static const struct { const char* name; int ranks[3]; int n; const char* extra; } cases[]={
+        {"one rare word",           {1000},     1, ""},
+        {"two mid-rank words",      {50,100},   2, ""},
+        {"rare word + city",        {300},      1, " dhaka"},
+        {"three common words",      {4,9,19},   3, ""},
+        {"most common word",        {0},        1, ""},
+    };
+    printf("%-20s | %-22s | %9s | %9s | %10s\n","Query","Terms","Matches","Index ms","Scan ms");
+    for(size_t k=0;k<sizeof(cases)/sizeof(cases[0]);k++){
+        char query[96]="";
+        for(int i=0;i<cases[k].n;i++){
+            char word[8];
+            bench_vocab_word(cases[k].ranks[i],word);
+            snprintf(query+strlen(query),sizeof(query)-strlen(query),"%s%s",i?" ":"",word);
+        }
+        snprintf(query+strlen(query),sizeof(query)-strlen(query),"%s",cases[k].extra);
+        TextHit hits[BROWSE_PAGE_SIZE];
+        long matched=0;
+        double best=HUGE_VAL;
+        for(int run=0;run<20;run++){
+            double q0=now_seconds();
+            text_search(query,true,hits,BROWSE_PAGE_SIZE,&matched);
+            double ms=(now_seconds()-q0)*1e3;
+            if(ms<best) best=ms;
+        }
+        double s0=now_seconds();
+        long scanned=bench_scan_matches(query);
+        double scan_ms=(now_seconds()-s0)*1e3;
+        printf("%-20s | %-22s | %9ld | %9.3f | %10.1f%s\n",cases[k].name,query,matched,best,scan_ms,
+               matched==scanned?"":"  MISMATCH");
+    }
+    return 0;
+}
+
+// --bench-tables [rows]: append rows records to each table through add_user,
+// add_house and add_rental (index upkeep included) and report the append
+// rate, the table's own allocation and the growth in resident memory.
+// Defaults to 1M rows per table.
+
+// Resident set size in KiB, or -1 where it is not available.
+static long bench_rss_kib(void){
+#if defined(__linux__)
+    FILE* fp=fopen("/proc/self/statm","r");
+    long pages=-1, rss=-1;
+    if(fp){
+        if(fscanf(fp,"%ld %ld",&pages,&rss)!=2) rss=-1;
+        fclose(fp);
+    }
+    return rss<0?-1:rss*(sysconf(_SC_PAGESIZE)/1024);
+#else
+    return -1;
+#endif
+}
+
+static void bench_table_row(const char* name, int rows, double secs, size_t table_bytes, long rss0){
+    long rss=bench_rss_kib();
+    printf("%-8s | %10d | %8.2f s | %8.2f | %10.1f | ",name,rows,secs,rows/secs/1e6,table_bytes/1048576.0);
+    if(rss<0 || rss0<0) printf("%10s\n","n/a");
+    else printf("%10.1f\n",(rss-rss0)/1024.0);
+}
+
+static int run_tables_bench(int argc, char** argv){
+    int rows = argc>2 ? atoi(argv[2]) : 1000000;
+    if(rows<=0){
+        fprintf(stderr,"Usage: %s --bench-tables [rows]\n",argv[0]);
+        return 2;
+    }
+    long rss=bench_rss_kib();
+    printf("Growable tables, %d rows each, one thread; empty tables: ",rows);
+    if(rss<0) printf("RSS n/a\n"); else printf("RSS %.1f MiB\n",rss/1024.0);
+    printf("%-8s | %10s | %10s | %8s | %10s | %10s\n","Table","Rows","Append","M rows/s","Table MiB","RSS +MiB");
+
+    double t0=now_seconds();
+    for(int i=0;i<rows;i++){
+        User u;
+        char name[32], email[48], phone[16];
+        memset(&u,0,sizeof(u));
+        u.id=i+1;
+        u.role=(i%10)?ROLE_TENANT:ROLE_LANDLORD;
+        u.is_active=true;
+        snprintf(name,sizeof(name),"user%07d",i+1);
+        snprintf(email,sizeof(email),"user%d@example.com",i+1);
+        snprintf(phone,sizeof(phone),"01%09d",i+1);
+        user_set_text(&u,name,"secret","Synthetic User",email,phone);
+        add_user(&u);
+    }
+    bench_table_row("users",rows,now_seconds()-t0,(size_t)user_cap*sizeof(User)+user_arena.cap,rss);
+
+    rss=bench_rss_kib();
+    srand(1);
+    t0=now_seconds();
+    for(int i=0;i<rows;i++){
+        House h;
+        bench_house(i,&h);
+        add_house(&h);
+    }
+    bench_table_row("houses",rows,now_seconds()-t0,
+                    (size_t)house_cap*(sizeof(HouseRow)+sizeof(HouseText)+2*sizeof(int32_t)+sizeof(int64_t)+1)+
+                    house_arena.cap,rss);
+
+    rss=bench_rss_kib();
+    t0=now_seconds();
+    for(int i=0;i<rows;i++){
+        Rental r;
+        memset(&r,0,sizeof(r));
+        r.id=i+1;
+        r.house_id=1+i%rows;
+        r.tenant_id=1+(i*7)%rows;
+        r.landlord_id=1+(r.house_id-1)/20;
+        snprintf(r.rental_date,sizeof(r.rental_date),"2024-%02d-%02d",1+i%12,1+i%28);
+        r.monthly_rent=500+i%9500;
+        r.is_active=(i%4)==0;
+        add_rental(&r);
+    }
+    bench_table_row("rentals",rows,now_seconds()-t0,(size_t)rental_cap*sizeof(Rental),rss);
+    return 0;
+}
+
+// --bench-scan [rows]: a three-predicate scan (available, 2+ bedrooms, rent
+// <= 5000) over the hot HouseRow array, next to the same scan over whole
+// House records, the layout houses[] had before the hot/cold split.
+// Defaults to 250k houses (about 260 MB of whole records).
+static long bench_scan_rows(const HouseRow* r, int rows){
+    long hits=0;
+    for(int i=0;i<rows;i++)
+        if(r[i].status==STATUS_AVAILABLE && r[i].bedrooms>=2 && r[i].rent<=5000.0) hits++;
+    return hits;
+}
+
+static long bench_scan_records(const House* h, int rows){
+    long hits=0;
+    for(int i=0;i<rows;i++)
+        if(h[i].status==STATUS_AVAILABLE && h[i].bedrooms>=2 && h[i].rent<=5000.0) hits++;
+    return hits;
+}
+
+static int run_scan_bench(int argc, char** argv){
+    int rows = argc>2 ? atoi(argv[2]) : 250000;
+    if(rows<=0){
+        fprintf(stderr,"Usage: %s --bench-scan [rows]\n",argv[0]);
+        return 2;
+    }
+    House* whole=malloc((size_t)rows*sizeof(House));
+    if(!whole){ fprintf(stderr,"Out of memory\n"); return 1; }
+    bench_fill_houses(rows);
+    for(int i=0;i<rows;i++) house_load(i,&whole[i]);
+    printf("Scan, %d houses, one thread, best of 5\n",rows);
+    printf("%-22s | %8s | %9s | %10s | %9s\n","Layout","Row B","ms","M rows/s","Matches");
+    for(int layout=0;layout<2;layout++){
+        double best=HUGE_VAL;
+        long hits=0;
+        for(int run=0;run<5;run++){
+            double t0=now_seconds();
+            hits = layout ? bench_scan_records(whole,rows) : bench_scan_rows(houses,rows);
+            double secs=now_seconds()-t0;
+            if(secs<best) best=secs;
+        }
+        printf("%-22s | %8u | %9.2f | %10.1f | %9ld\n",layout?"whole House records":"hot HouseRow",
+               (unsigned)(layout?sizeof(House):sizeof(HouseRow)),best*1e3,rows/best/1e6,hits);
+    }
+    free(whole);
+    return 0;
+}
+
+// --------------- Role Menus ---------------
+static void admin_menu(void){
+    for(;;){
+        clear_screen();
+        printf(RED "==================== A D M I N ====================\n" RESET);
+        printf("1. List Users\n2. Toggle User Active\n3. Reset User Password\n4. List Houses\n5. List Rentals\n6. Rental Report (incl. archive)\n7. Memory Report\n8. Back\n");
+        int c = read_int_range("Choice: ",1,8,8,false);
+        if(c==1) admin_list_users();
+        else if(c==2) admin_toggle_active();
+        else if(c==3) admin_reset_password();
+        else if(c==4) admin_list_houses();
+        else if(c==5) admin_list_rentals();
+        else if(c==6) admin_rental_report();
+        else if(c==7) admin_memory_report();
+        else break;
+        pause_enter();
+    }
+}
+
+static void landlord_menu(User* me){
+    for(;;){
+        clear_screen();
+        printf(RED "================== L A N D L O R D =================\n" RESET);
+        printf("1. Add House\n2. Edit House\n3. Delete House\n4. Change House Status\n5. My Houses\n6. My Rentals\n7. Back\n");
+        int c = read_int_range("Choice: ",1,7,7,false);
+        if(c==1) landlord_add_house(me);
+        else if(c==2) landlord_edit_house(me);
+        else if(c==3) landlord_delete_house(me);
+        else if(c==4) landlord_change_status(me);
+        else if(c==5) landlord_list_my_houses(me);
+        else if(c==6) landlord_view_rentals(me);
+        else break;
+        pause_enter();
+    }
+}
+
+static void tenant_menu(User* me){
+    for(;;){
+        clear_screen();
+        printf(RED "=================== T E N A N T ====================\n" RESET);
+        printf("1. Browse Available Houses\n2. Browse by City/Area\n3. Browse by Price\n4. Search Listings\n5. Filter Houses\n6. House Details\n7. Rent a House\n8. My Rentals\n9. End Rental\n10. Back\n");
+        int c = read_int_range("Choice: ",1,10,10,false);
+        if(c==1) tenant_browse_available();
+        else if(c==2) tenant_browse_by_location();
+        else if(c==3) tenant_browse_by_price();
+        else if(c==4) tenant_search_listings();
+        else if(c==5) tenant_search_houses();
+        else if(c==6) tenant_view_house_details();
+        else if(c==7) tenant_rent_house(me);
+        else if(c==8) tenant_view_my_rentals(me);
+        else if(c==9) tenant_end_rental(me);
+        else break;
+        pause_enter();
+    }
+}
+
+// ---------------- Main Menu ---------------
+static int menu_main(void){
+    clear_screen();
+    printf(RED "======================\n");
+    printf("   M A I N  M E N U\n");
+    printf(RED "======================\n" RESET);
+    printf(GREEN  "1. Login\n" RESET);
+    printf(YELLOW "2. Register\n" RESET);
+    printf(RED    "3. Exit\n" RESET);
+    return read_int_range("Choose an option: ",1,3,3,false);
+}
+
+// -------------------- main ----------------
+int main(int argc, char** argv){
+    if(argc>1){
+        if(strcmp(argv[1],"--import")==0) return run_import(argc,argv);
+        if(strcmp(argv[1],"--bench-filter")==0) return run_filter_bench(argc,argv);
+        if(strcmp(argv[1],"--bench-load")==0) return run_load_bench(argc,argv);
+        if(strcmp(argv[1],"--bench-lookup")==0) return run_lookup_bench(argc,argv);
+        if(strcmp(argv[1],"--bench-login")==0) return run_login_bench(argc,argv);
+        if(strcmp(argv[1],"--bench-browse")==0) return run_browse_bench(argc,argv);
+        if(strcmp(argv[1],"--bench-search")==0) return run_search_bench(argc,argv);
+        if(strcmp(argv[1],"--bench-tables")==0) return run_tables_bench(argc,argv);
+        if(strcmp(argv[1],"--bench-scan")==0) return run_scan_bench(argc,argv);
+        fprintf(stderr,"Usage: %s [--import <users|houses|rentals> <file> ... | --bench-filter [rows] |\n"
+                       "       --bench-load [rows ...] | --bench-lookup [rows ...] | --bench-login [users ...] |\n"
+                       "       --bench-browse [rows] [available %%] | --bench-search [rows] | --bench-tables [rows] |\n"
+                       "       --bench-scan [rows]]\n",argv[0]);
+        return 2;
+    }
+
+    enable_vt_mode();  // ANSI colors on Windows 10+ terminals
+    splash();          // fancy animated welcome
+    load_all();
+
+    for(;;){
+        int choice = menu_main();
+        if(choice==1){
+            User* u = authenticate();
+            if(u){
+                if(u->role==ROLE_ADMIN) admin_menu();
+                else if(u->role==ROLE_LANDLORD) landlord_menu(u);
+                else tenant_menu(u);
+            } else {
+                pause_enter();
+            }
+        } else if(choice==2){
+            register_user();
+            pause_enter();
+        } else {
+            save_all();
+            printf(GREEN "Goodbye!\n" RESET);
+            break;
+        }
+    }
+    return 0;
+}